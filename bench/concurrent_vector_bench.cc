@@ -0,0 +1,122 @@
+/*
+ * Copyright 2016 Waizung Taam
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ==== concurrent_vector scaling benchmark ==== */
+
+// $ ./concurrent_vector_bench.o [elements] [max_threads]
+//
+// Appends elements longs (default 10^7) split evenly over 1, 2, 4, ... up
+// to max_threads threads (default: one per hardware thread), and collects
+// them into one contiguous mystl::vector in three ways:
+//
+//   concurrent  push_back() into a shared concurrent_vector, then compact()
+//   merge       push_back() into a private vector per thread, then insert
+//               them all at the end of one vector
+//   mutex       push_back() into a shared vector under a std::mutex
+//
+// and prints the best of 3 wall times and the throughput.
+
+#include "../include/concurrent_vector.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+
+class Timer {
+public:
+  Timer() : begin_(std::chrono::steady_clock::now()) {}
+  double ms() const {
+    return std::chrono::duration<double, std::milli>(
+      std::chrono::steady_clock::now() - begin_).count();
+  }
+private:
+  std::chrono::steady_clock::time_point begin_;
+};
+
+template <typename Work>
+void run_threads(unsigned threads, const Work& work) {
+  std::thread* pool = new std::thread[threads];
+  for (unsigned t = 0; t < threads; ++t) pool[t] = std::thread(work, t);
+  for (unsigned t = 0; t < threads; ++t) pool[t].join();
+  delete[] pool;
+}
+
+double concurrent(size_t n, unsigned threads) {
+  Timer timer;
+  mystl::concurrent_vector<long> shared;
+  run_threads(threads, [&](unsigned t) {
+    for (size_t i = t; i < n; i += threads) shared.push_back(long(i));
+  });
+  mystl::vector<long> result = shared.compact();
+  return timer.ms();
+}
+
+double merge(size_t n, unsigned threads) {
+  Timer timer;
+  mystl::vector<mystl::vector<long>> parts(threads);
+  run_threads(threads, [&](unsigned t) {
+    for (size_t i = t; i < n; i += threads) parts[t].push_back(long(i));
+  });
+  mystl::vector<long> result;
+  for (unsigned t = 0; t < threads; ++t) {
+    result.insert(result.end(), parts[t].begin(), parts[t].end());
+  }
+  return timer.ms();
+}
+
+double locked(size_t n, unsigned threads) {
+  Timer timer;
+  mystl::vector<long> result;
+  std::mutex mutex;
+  run_threads(threads, [&](unsigned t) {
+    for (size_t i = t; i < n; i += threads) {
+      std::lock_guard<std::mutex> lock(mutex);
+      result.push_back(long(i));
+    }
+  });
+  return timer.ms();
+}
+
+double best_of_3(double (*run)(size_t, unsigned), size_t n,
+                 unsigned threads) {
+  double best = run(n, threads);
+  for (int r = 1; r < 3; ++r) {
+    double ms = run(n, threads);
+    if (ms < best) best = ms;
+  }
+  return best;
+}
+
+int main(int argc, char* argv[]) {
+  size_t n = argc > 1 ? std::strtoul(argv[1], 0, 10) : 10000000;
+  unsigned max_threads = argc > 2 ? unsigned(std::atoi(argv[2])) :
+                         std::thread::hardware_concurrency();
+  if (max_threads == 0) max_threads = 1;
+  std::printf("%8s %-11s %10s %12s\n", "threads", "method", "ms", "Mops/s");
+  for (unsigned threads = 1; ; threads *= 2) {
+    if (threads > max_threads) threads = max_threads;
+    const char* names[] = {"concurrent", "merge", "mutex"};
+    double (*runs[])(size_t, unsigned) = {&concurrent, &merge, &locked};
+    for (int m = 0; m < 3; ++m) {
+      double ms = best_of_3(runs[m], n, threads);
+      std::printf("%8u %-11s %10.2f %12.1f\n", threads, names[m], ms,
+                  n / ms / 1000);
+    }
+    if (threads == max_threads) break;
+  }
+}
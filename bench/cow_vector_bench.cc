@@ -0,0 +1,101 @@
+/*
+ * Copyright 2016 Waizung Taam
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ==== cow_vector benchmark ==== */
+
+// $ ./cow_vector_bench.o [max_elements] [copies]
+//
+// Hands a table of routes to each of [copies] workers (default 256), as a
+// reload of shared configuration does, then has every worker scan its
+// copy once. Compares copying a vector with copying a cow_vector. Best
+// of 5 runs, in milliseconds.
+
+#include "../include/cow_vector.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+struct Route {
+  unsigned prefix;
+  unsigned mask;
+  long next_hop;
+};
+
+class Timer {
+public:
+  Timer() : begin_(std::chrono::steady_clock::now()) {}
+  double ms() const {
+    return std::chrono::duration<double, std::milli>(
+      std::chrono::steady_clock::now() - begin_).count();
+  }
+private:
+  std::chrono::steady_clock::time_point begin_;
+};
+
+template <typename Vector>
+long scan(const Vector& routes) {
+  long sum = 0;
+  for (size_t i = 0; i < routes.size(); ++i) sum += routes[i].next_hop;
+  return sum;
+}
+
+// Returns the time to make the copies and the time to scan them.
+template <typename Vector>
+void distribute(const Vector& table, size_t copies, double& copy_ms,
+                double& scan_ms, long& sum) {
+  mystl::vector<Vector> workers(copies);
+  Timer timer;
+  for (size_t i = 0; i < copies; ++i) workers[i] = table;
+  copy_ms = timer.ms();
+  Timer scan_timer;
+  sum = 0;
+  for (size_t i = 0; i < copies; ++i) sum += scan(workers[i]);
+  scan_ms = scan_timer.ms();
+}
+
+void keep_best(double& best, double ms, int run) {
+  if (run == 0 || ms < best) best = ms;
+}
+
+int main(int argc, char* argv[]) {
+  size_t max_n = argc > 1 ? std::strtoul(argv[1], 0, 10) : 1000000;
+  size_t copies = argc > 2 ? std::strtoul(argv[2], 0, 10) : 256;
+  std::printf("%10s %8s | %10s %10s | %10s %10s\n", "n", "copies",
+              "vec copy", "vec scan", "cow copy", "cow scan");
+  for (size_t n = 1000; n <= max_n; n *= 10) {
+    mystl::vector<Route> routes;
+    for (size_t i = 0; i < n; ++i) {
+      Route r = {unsigned(i), 24, long(i % 64)};
+      routes.push_back(r);
+    }
+    mystl::cow_vector<Route> shared = routes;
+    double vec_copy = 0, vec_scan = 0, cow_copy = 0, cow_scan = 0;
+    for (int r = 0; r < 5; ++r) {
+      double copy_ms, scan_ms;
+      long vec_sum, cow_sum;
+      distribute(routes, copies, copy_ms, scan_ms, vec_sum);
+      keep_best(vec_copy, copy_ms, r);
+      keep_best(vec_scan, scan_ms, r);
+      distribute(shared, copies, copy_ms, scan_ms, cow_sum);
+      keep_best(cow_copy, copy_ms, r);
+      keep_best(cow_scan, scan_ms, r);
+      if (vec_sum != cow_sum) std::abort();
+    }
+    std::printf("%10zu %8zu | %10.3f %10.3f | %10.3f %10.3f\n", n, copies,
+                vec_copy, vec_scan, cow_copy, cow_scan);
+  }
+}
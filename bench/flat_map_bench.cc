@@ -0,0 +1,127 @@
+/*
+ * Copyright 2016 Waizung Taam
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ==== flat_map benchmark ==== */
+
+// $ ./flat_map_bench.o [max_elements]
+//
+// Lookups: ns per find() of a random present key in a map of n ints, for
+// - std::map,
+// - std::lower_bound over a sorted vector, as hand-rolled code does,
+// - flat_map with branchless binary search,
+// - flat_map with its Eytzinger index.
+// Bulk insertion: ms to add n / 10 random keys to a flat_map of n keys,
+// one insert() at a time versus one insert() of the whole range.
+
+#include "../include/flat_map.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <vector>
+
+class Timer {
+public:
+  Timer() : begin_(std::chrono::steady_clock::now()) {}
+  double ns() const {
+    return std::chrono::duration<double, std::nano>(
+      std::chrono::steady_clock::now() - begin_).count();
+  }
+private:
+  std::chrono::steady_clock::time_point begin_;
+};
+
+typedef mystl::flat_map<int, int> FlatMap;
+
+unsigned next_random(unsigned& state) {
+  state = state * 1664525u + 1013904223u;
+  return state >> 1;
+}
+
+template <typename Find>
+double time_lookups(const std::vector<int>& probes, Find find) {
+  long sum = 0;
+  Timer timer;
+  for (size_t i = 0; i < probes.size(); ++i) sum += find(probes[i]);
+  double ns = timer.ns() / probes.size();
+  if (sum == 42) std::printf(" ");
+  return ns;
+}
+
+void lookups(size_t n) {
+  unsigned state = 1;
+  std::vector<int> keys;
+  for (size_t i = 0; i < n; ++i) keys.push_back(int(i * 2));
+  std::map<int, int> tree;
+  FlatMap flat;
+  mystl::vector<mystl::pair<int, int>> pairs;
+  for (size_t i = 0; i < n; ++i) {
+    tree[keys[i]] = int(i);
+    pairs.push_back(mystl::make_pair(keys[i], int(i)));
+  }
+  flat.insert_sorted(pairs.begin(), pairs.end());
+  std::vector<int> probes;
+  for (size_t i = 0; i < 1000000; ++i) {
+    probes.push_back(keys[next_random(state) % n]);
+  }
+  double tree_ns = time_lookups(probes, [&](int k) {
+    return tree.find(k)->second;
+  });
+  double vector_ns = time_lookups(probes, [&](int k) {
+    return *std::lower_bound(keys.begin(), keys.end(), k);
+  });
+  double flat_ns = time_lookups(probes, [&](int k) {
+    return flat.find(k)->second;
+  });
+  flat.build_index();
+  double eytzinger_ns = time_lookups(probes, [&](int k) {
+    return flat.find(k)->second;
+  });
+  std::printf("%10zu | %10.1f %10.1f %10.1f %10.1f\n", n, tree_ns,
+              vector_ns, flat_ns, eytzinger_ns);
+}
+
+void bulk_insert(size_t n) {
+  unsigned state = 2;
+  mystl::vector<mystl::pair<int, int>> base, extra;
+  for (size_t i = 0; i < n; ++i) {
+    base.push_back(mystl::make_pair(int(i * 2), 0));
+  }
+  for (size_t i = 0; i < n / 10; ++i) {
+    extra.push_back(mystl::make_pair(int(next_random(state) % (2 * n)), 1));
+  }
+  FlatMap one_by_one(mystl::sorted_unique, FlatMap::vector_type(base));
+  Timer timer;
+  for (size_t i = 0; i < extra.size(); ++i) one_by_one.insert(extra[i]);
+  double single_ms = timer.ns() / 1e6;
+  FlatMap merged(mystl::sorted_unique, FlatMap::vector_type(base));
+  Timer merge_timer;
+  merged.insert(extra.begin(), extra.end());
+  double merge_ms = merge_timer.ns() / 1e6;
+  if (one_by_one != merged) std::abort();
+  std::printf("%10zu | %10.2f %10.2f\n", n, single_ms, merge_ms);
+}
+
+int main(int argc, char* argv[]) {
+  size_t max_n = argc > 1 ? std::strtoul(argv[1], 0, 10) : 10000000;
+  std::printf("%10s | %10s %10s %10s %10s\n", "n", "std::map",
+              "lower_bnd", "flat_map", "eytzinger");
+  for (size_t n = 1000; n <= max_n; n *= 10) lookups(n);
+  std::printf("\n%10s | %10s %10s\n", "n", "insert ms", "merge ms");
+  for (size_t n = 1000; n <= max_n / 10; n *= 10) bulk_insert(n);
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright 2016 Waizung Taam
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ==== vector growth policy benchmark ==== */
+
+// $ ./growth_policy_bench.o [max_elements]
+//
+// Appends elements one by one with push_back() and reports, per growth
+// policy: time per push_back, number of reallocations, final capacity and
+// the share of the final buffer that is unused.
+
+#include "../include/vector.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+template <typename Tp, typename GrowthPolicy>
+void run(const char* type_name, const char* policy_name, size_t n,
+         const Tp& value) {
+  typedef mystl::vector<Tp, mystl::new_allocator<Tp>, GrowthPolicy> Vector;
+  const int rounds = n >= 10000000 ? 1 : 5;
+  double best_ns = 0;
+  size_t reallocations = 0, capacity = 0;
+  for (int r = 0; r < rounds; ++r) {
+    Vector v;
+    size_t last_capacity = 0;
+    reallocations = 0;
+    std::chrono::steady_clock::time_point begin =
+      std::chrono::steady_clock::now();
+    for (size_t i = 0; i < n; ++i) {
+      v.push_back(value);
+      if (v.capacity() != last_capacity) {
+        last_capacity = v.capacity();
+        ++reallocations;
+      }
+    }
+    double ns = std::chrono::duration<double, std::nano>(
+      std::chrono::steady_clock::now() - begin).count();
+    if (r == 0 || ns < best_ns) best_ns = ns;
+    capacity = v.capacity();
+  }
+  std::printf("%-12s %-12s %10zu %10.2f %8zu %12zu %7.1f%%\n",
+              type_name, policy_name, n, best_ns / n, reallocations,
+              capacity, 100.0 * (capacity - n) / capacity);
+}
+
+template <typename Tp>
+void run_all(const char* type_name, size_t n, const Tp& value) {
+  run<Tp, mystl::double_growth>(type_name, "2x", n, value);
+  run<Tp, mystl::one_and_half_growth>(type_name, "1.5x", n, value);
+  run<Tp, mystl::size_class_growth<> >(type_name, "size-class", n, value);
+  run<Tp, mystl::huge_page_growth<> >(type_name, "huge-page", n, value);
+}
+
+int main(int argc, char* argv[]) {
+  size_t max_n = argc > 1 ? std::strtoul(argv[1], 0, 10) : 10000000;
+  std::printf("%-12s %-12s %10s %10s %8s %12s %8s\n", "type", "policy",
+              "n", "ns/push", "reallocs", "capacity", "slack");
+  for (size_t n = 1000; n <= max_n; n *= 10) {
+    run_all<int>("int", n, 1);
+    run_all<std::string>("std::string", n / 10, std::string(32, 'x'));
+  }
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright 2016 Waizung Taam
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ==== large vector growth benchmark ==== */
+
+// $ ./large_growth_bench.o [max_bytes]
+//
+// Grows vectors up to max_bytes (default 1 GiB) with push_back(), once
+// with new_allocator and once with large_buffer_allocator, and reports
+// the total time and the longest single push_back(), i.e. the worst
+// reallocation pause. long is reallocated with mremap(); Wide has a
+// user-provided copy constructor, so only expand_in_place() applies.
+// segmented_vector, which never reallocates, is the baseline: its worst
+// push_back() only allocates a new segment.
+
+#include "../include/mmap_allocator.h"
+#include "../include/segmented_vector.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+struct Wide {
+  Wide(long x) : value(x) {}
+  Wide(const Wide& other) : value(other.value) {}
+  Wide& operator=(const Wide& other) {
+    value = other.value;
+    return *this;
+  }
+  long value;
+};
+
+template <typename Vector>
+void run(const char* type_name, const char* container_name, size_t n) {
+  typedef std::chrono::steady_clock clock;
+  Vector v;
+  double worst_ms = 0;
+  clock::time_point begin = clock::now(), last = begin;
+  for (size_t i = 0; i < n; ++i) {
+    v.push_back(long(i));
+    if (v.size() == v.capacity() || i + 1 == n) {
+      // The next push_back() reallocates: time it separately.
+      clock::time_point now = clock::now();
+      if (i + 1 < n) {
+        v.push_back(long(++i));
+        clock::time_point after = clock::now();
+        double ms = std::chrono::duration<double, std::milli>(
+          after - now).count();
+        if (ms > worst_ms) worst_ms = ms;
+        now = after;
+      }
+      last = now;
+    }
+  }
+  double total_ms = std::chrono::duration<double, std::milli>(
+    last - begin).count();
+  std::printf("%-6s %-20s %12zu %10.1f %12.2f\n", type_name, container_name,
+              n, total_ms, worst_ms);
+}
+
+template <typename Tp>
+void run_all(const char* type_name, size_t n) {
+  run<mystl::vector<Tp> >(type_name, "vector/new", n);
+  run<mystl::vector<Tp, mystl::large_buffer_allocator<Tp> > >(
+    type_name, "vector/large_buffer", n);
+  run<mystl::segmented_vector<Tp> >(type_name, "segmented_vector", n);
+}
+
+int main(int argc, char* argv[]) {
+  size_t max_bytes = argc > 1 ? std::strtoul(argv[1], 0, 10) : (1ul << 30);
+  std::printf("%-6s %-20s %12s %10s %12s\n", "type", "container", "n",
+              "total ms", "worst ms");
+  for (size_t bytes = 1ul << 24; bytes <= max_bytes; bytes *= 4) {
+    run_all<long>("long", bytes / sizeof(long));
+    run_all<Wide>("Wide", bytes / sizeof(Wide));
+  }
+}
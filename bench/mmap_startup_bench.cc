@@ -0,0 +1,134 @@
+/*
+ * Copyright 2016 Waizung Taam
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ==== mmap_vector startup benchmark ==== */
+
+// $ ./mmap_startup_bench.o [max_elements] [directory]
+//
+// Compares the time until a persisted dataset is usable:
+// - deserialize: fread() the records from a flat file and push_back() each
+//   one into a vector,
+// - mmap open:   open the same data as an mmap_vector,
+// and, since mmap_vector reads lazily, the time of one pass summing the
+// records right after opening. The files are freshly written, so both
+// read from a warm page cache. Best of 5 runs.
+
+#include "../include/mmap_allocator.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+struct Record {
+  long id;
+  double values[6];
+};
+
+class Timer {
+public:
+  Timer() : begin_(std::chrono::steady_clock::now()) {}
+  double ms() const {
+    return std::chrono::duration<double, std::milli>(
+      std::chrono::steady_clock::now() - begin_).count();
+  }
+private:
+  std::chrono::steady_clock::time_point begin_;
+};
+
+Record make_record(size_t i) {
+  Record r;
+  r.id = long(i);
+  for (int k = 0; k < 6; ++k) r.values[k] = double(i) + k;
+  return r;
+}
+
+template <typename Vector>
+long checksum(const Vector& v) {
+  long sum = 0;
+  for (size_t i = 0; i < v.size(); ++i) sum += v[i].id;
+  return sum;
+}
+
+void write_files(const std::string& flat, const std::string& mapped,
+                 size_t n) {
+  std::FILE* out = std::fopen(flat.c_str(), "wb");
+  if (out == 0) std::abort();
+  std::remove(mapped.c_str());
+  mystl::mmap_vector<Record> v(mapped.c_str());
+  v.reserve(n);
+  for (size_t i = 0; i < n; ++i) {
+    Record r = make_record(i);
+    std::fwrite(&r, sizeof(r), 1, out);
+    v.push_back(r);
+  }
+  std::fclose(out);
+  v.sync();
+}
+
+void run(const std::string& flat, const std::string& mapped, size_t n) {
+  double best_load = 0, best_load_scan = 0;
+  double best_open = 0, best_open_scan = 0;
+  long sum_load = 0, sum_open = 0;
+  for (int r = 0; r < 5; ++r) {
+    {
+      Timer timer;
+      mystl::vector<Record> v;
+      std::FILE* in = std::fopen(flat.c_str(), "rb");
+      Record record;
+      while (std::fread(&record, sizeof(record), 1, in) == 1) {
+        v.push_back(record);
+      }
+      std::fclose(in);
+      double load = timer.ms();
+      sum_load = checksum(v);
+      double load_scan = timer.ms();
+      if (r == 0 || load < best_load) best_load = load;
+      if (r == 0 || load_scan < best_load_scan) best_load_scan = load_scan;
+    }
+    {
+      Timer timer;
+      mystl::mmap_vector<Record> v(mapped.c_str());
+      double open = timer.ms();
+      sum_open = checksum(v);
+      double open_scan = timer.ms();
+      if (r == 0 || open < best_open) best_open = open;
+      if (r == 0 || open_scan < best_open_scan) best_open_scan = open_scan;
+    }
+  }
+  if (sum_load != sum_open) {
+    std::printf("checksum mismatch\n");
+    std::exit(1);
+  }
+  std::printf("%10zu %10.1f %14.3f %14.3f %14.3f %14.3f\n", n,
+              n * sizeof(Record) / 1048576.0, best_load, best_open,
+              best_load_scan, best_open_scan);
+}
+
+int main(int argc, char* argv[]) {
+  size_t max_n = argc > 1 ? std::strtoul(argv[1], 0, 10) : 10000000;
+  std::string dir = argc > 2 ? argv[2] : ".";
+  std::string flat = dir + "/mmap_startup_bench.bin";
+  std::string mapped = dir + "/mmap_startup_bench.vec";
+  std::printf("%10s %10s %14s %14s %14s %14s\n", "n", "MiB",
+              "deserialize ms", "mmap open ms", "deser+scan ms", "open+scan ms");
+  for (size_t n = 1000; n <= max_n; n *= 10) {
+    write_files(flat, mapped, n);
+    run(flat, mapped, n);
+  }
+  std::remove(flat.c_str());
+  std::remove(mapped.c_str());
+}
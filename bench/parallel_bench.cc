@@ -0,0 +1,94 @@
+/*
+ * Copyright 2016 Waizung Taam
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ==== parallel algorithms benchmark ==== */
+
+// $ ./parallel_bench.o [max_elements] [threads]
+//
+// Times, for vectors of long from 10^4 up to max_elements (default 10^8),
+// fill construction, copy construction, an in-place transform and a sum,
+// once serially and once through a thread pool (default: one thread per
+// hardware thread). Construction includes the page faults of the fresh
+// buffer, which the parallel version spreads over the pool. Best of 3.
+
+#include "../include/parallel.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+class Timer {
+public:
+  Timer() : begin_(std::chrono::steady_clock::now()) {}
+  double ms() const {
+    return std::chrono::duration<double, std::milli>(
+      std::chrono::steady_clock::now() - begin_).count();
+  }
+private:
+  std::chrono::steady_clock::time_point begin_;
+};
+
+struct Times {
+  double construct, copy, transform, reduce;
+};
+
+long plus(long x, long y) { return x + y; }
+long step(long x) { return x * 3 + 1; }
+
+Times run(const mystl::parallel_policy& policy, size_t n) {
+  Times best = {0, 0, 0, 0};
+  for (int r = 0; r < 3; ++r) {
+    Times t;
+    Timer construct;
+    mystl::parallel_vector<long> a(n, 1L, policy);
+    t.construct = construct.ms();
+    Timer copy;
+    mystl::parallel_vector<long> b(a);
+    t.copy = copy.ms();
+    Timer transform;
+    mystl::parallel_transform(policy, b.data(), b.data() + n, b.data(), step);
+    t.transform = transform.ms();
+    Timer reduce;
+    volatile long sum = mystl::parallel_reduce(policy, b.data(),
+                                               b.data() + n, 0L, plus);
+    (void)sum;
+    t.reduce = reduce.ms();
+    if (r == 0 || t.construct < best.construct) best.construct = t.construct;
+    if (r == 0 || t.copy < best.copy) best.copy = t.copy;
+    if (r == 0 || t.transform < best.transform) best.transform = t.transform;
+    if (r == 0 || t.reduce < best.reduce) best.reduce = t.reduce;
+  }
+  return best;
+}
+
+int main(int argc, char* argv[]) {
+  size_t max_n = argc > 1 ? std::strtoul(argv[1], 0, 10) : 100000000;
+  unsigned threads = argc > 2 ? unsigned(std::atoi(argv[2])) : 0;
+  mystl::thread_pool pool(threads);
+  // A threshold larger than any vector keeps everything serial.
+  mystl::parallel_policy serial(&pool, size_t(-1));
+  mystl::parallel_policy parallel(&pool);
+  std::printf("%u threads\n", pool.concurrency());
+  std::printf("%12s %-9s %12s %12s %12s %12s\n", "n", "mode",
+              "construct ms", "copy ms", "transform ms", "reduce ms");
+  for (size_t n = 10000; n <= max_n; n *= 10) {
+    Times s = run(serial, n), p = run(parallel, n);
+    std::printf("%12zu %-9s %12.3f %12.3f %12.3f %12.3f\n", n, "serial",
+                s.construct, s.copy, s.transform, s.reduce);
+    std::printf("%12zu %-9s %12.3f %12.3f %12.3f %12.3f\n", n, "parallel",
+                p.construct, p.copy, p.transform, p.reduce);
+  }
+}
@@ -0,0 +1,125 @@
+/*
+ * Copyright 2016 Waizung Taam
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ==== array-of-structures vs. structure-of-arrays benchmark ==== */
+
+// $ ./soa_bench.o [rows]
+//
+// Stores rows (default 10^7) 64-byte records as vector<Record> and as a
+// soa_vector with the same fields, then times scans that touch one or two
+// fields: summing a column, scaling a column in place, and a filtered sum
+// reading two columns. Best of 5, in ns per row.
+
+#include "../include/soa_vector.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+struct Record {
+  long id;
+  double price;
+  int quantity;
+  int flags;
+  char name[40];
+};
+
+typedef mystl::soa_vector<long, double, int, int> Table;
+
+class Timer {
+public:
+  Timer() : begin_(std::chrono::steady_clock::now()) {}
+  double ns() const {
+    return std::chrono::duration<double, std::nano>(
+      std::chrono::steady_clock::now() - begin_).count();
+  }
+private:
+  std::chrono::steady_clock::time_point begin_;
+};
+
+volatile double sink;
+
+double sum_aos(mystl::vector<Record>& v) {
+  double sum = 0;
+  for (size_t i = 0; i < v.size(); ++i) sum += v[i].price;
+  return sum;
+}
+double sum_soa(Table& t) {
+  mystl::span<double> prices = t.column<1>();
+  double sum = 0;
+  for (size_t i = 0; i < prices.size(); ++i) sum += prices[i];
+  return sum;
+}
+double scale_aos(mystl::vector<Record>& v) {
+  for (size_t i = 0; i < v.size(); ++i) v[i].price *= 1.0001;
+  return 0;
+}
+double scale_soa(Table& t) {
+  mystl::span<double> prices = t.column<1>();
+  for (size_t i = 0; i < prices.size(); ++i) prices[i] *= 1.0001;
+  return 0;
+}
+double filter_aos(mystl::vector<Record>& v) {
+  double sum = 0;
+  for (size_t i = 0; i < v.size(); ++i) {
+    if (v[i].quantity > 50) sum += v[i].price;
+  }
+  return sum;
+}
+double filter_soa(Table& t) {
+  mystl::span<double> prices = t.column<1>();
+  mystl::span<int> quantities = t.column<2>();
+  double sum = 0;
+  for (size_t i = 0; i < prices.size(); ++i) {
+    if (quantities[i] > 50) sum += prices[i];
+  }
+  return sum;
+}
+
+template <typename Container>
+double best_of_5(double (*scan)(Container&), Container& c, size_t rows) {
+  double best = 0;
+  for (int r = 0; r < 5; ++r) {
+    Timer timer;
+    sink = scan(c);
+    double ns = timer.ns() / rows;
+    if (r == 0 || ns < best) best = ns;
+  }
+  return best;
+}
+
+int main(int argc, char* argv[]) {
+  size_t rows = argc > 1 ? std::strtoul(argv[1], 0, 10) : 10000000;
+  mystl::vector<Record> aos;
+  Table soa;
+  aos.reserve(rows);
+  soa.reserve(rows);
+  for (size_t i = 0; i < rows; ++i) {
+    Record r = {long(i), double(i % 1000), int(i % 100), 0, {0}};
+    aos.push_back(r);
+    soa.push_back(r.id, r.price, r.quantity, r.flags);
+  }
+  std::printf("%-8s %10s %10s %7s\n", "scan", "aos ns", "soa ns", "ratio");
+  const char* names[] = {"sum", "scale", "filter"};
+  double (*aos_scans[])(mystl::vector<Record>&) = {
+    &sum_aos, &scale_aos, &filter_aos};
+  double (*soa_scans[])(Table&) = {&sum_soa, &scale_soa, &filter_soa};
+  for (int s = 0; s < 3; ++s) {
+    double a = best_of_5(aos_scans[s], aos, rows);
+    double b = best_of_5(soa_scans[s], soa, rows);
+    std::printf("%-8s %10.3f %10.3f %7.2f\n", names[s], a, b, a / b);
+  }
+}
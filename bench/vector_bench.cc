@@ -0,0 +1,317 @@
+/*
+ * Copyright 2016 Waizung Taam
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ==== mystl::vector vs. std::vector benchmark ==== */
+
+// $ ./vector_bench.o [max_elements] [operation]
+//
+// Every case runs in a forked child, so that its peak RSS can be read
+// from wait4() independently of the other cases. For each operation,
+// element type and size the table shows, for mystl::vector and then for
+// std::vector, the time per element operation, the number of calls to
+// operator new and the peak RSS of the child, followed by the ratio of
+// the two times (< 1 means mystl is faster).
+//
+// Sizes go from 10 up to max_elements (default 10^6, up to 10^8) in
+// steps of 10. The operation argument restricts the run to one operation.
+
+#include "../include/vector.h"
+
+#include <sys/resource.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+
+static size_t allocation_count = 0;
+
+void* operator new(size_t n) {
+  ++allocation_count;
+  void* p = std::malloc(n != 0 ? n : 1);
+  if (p == 0) throw std::bad_alloc();
+  return p;
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+struct Pod64 {
+  long fields[8];
+  bool operator<(const Pod64& other) const {
+    return std::memcmp(fields, other.fields, sizeof(fields)) < 0;
+  }
+  bool operator!=(const Pod64& other) const {
+    return std::memcmp(fields, other.fields, sizeof(fields)) != 0;
+  }
+};
+
+template <typename Tp> Tp make(size_t i);
+template <> int make<int>(size_t i) { return int(i); }
+template <> Pod64 make<Pod64>(size_t i) {
+  Pod64 pod;
+  for (int k = 0; k < 8; ++k) pod.fields[k] = long(i) + k;
+  return pod;
+}
+template <> std::string make<std::string>(size_t i) {
+  char buffer[32];
+  std::snprintf(buffer, sizeof(buffer), "element-%020zu", i);  // no SSO
+  return buffer;
+}
+typedef mystl::vector<int> IntVector;  // trivially relocatable
+template <> IntVector make<IntVector>(size_t i) {
+  return IntVector(4, int(i));
+}
+
+template <typename Tp> using MyVector = mystl::vector<Tp>;
+template <typename Tp> using StdVector = std::vector<Tp>;
+
+/* Every operation builds its input outside the timed region and returns
+ * the elapsed nanoseconds together with the number of element operations
+ * it performed.
+ */
+struct Timing {
+  double ns;
+  size_t ops;
+};
+
+class Timer {
+public:
+  Timer() : begin_(std::chrono::steady_clock::now()) {}
+  double ns() const {
+    return std::chrono::duration<double, std::nano>(
+      std::chrono::steady_clock::now() - begin_).count();
+  }
+private:
+  std::chrono::steady_clock::time_point begin_;
+};
+
+template <template <typename> class Vector, typename Tp>
+void fill_vector(Vector<Tp>& v, size_t n) {
+  v.reserve(n);
+  for (size_t i = 0; i < n; ++i) v.push_back(make<Tp>(i));
+}
+
+template <template <typename> class Vector, typename Tp>
+Timing push_back_growth(size_t n) {
+  Tp value = make<Tp>(n);
+  Vector<Tp> v;
+  Timer timer;
+  for (size_t i = 0; i < n; ++i) v.push_back(value);
+  Timing t = {timer.ns(), n};
+  return t;
+}
+template <template <typename> class Vector, typename Tp>
+Timing reserve_fill(size_t n) {
+  Tp value = make<Tp>(n);
+  Vector<Tp> v;
+  Timer timer;
+  v.reserve(n);
+  for (size_t i = 0; i < n; ++i) v.push_back(value);
+  Timing t = {timer.ns(), n};
+  return t;
+}
+template <template <typename> class Vector, typename Tp>
+Timing mid_insert_erase(size_t n) {
+  Vector<Tp> v;
+  fill_vector<Vector, Tp>(v, n);
+  v.reserve(n + 1);
+  Tp value = make<Tp>(n);
+  size_t rounds = n < 1000 ? 1000 : 100;
+  Timer timer;
+  for (size_t i = 0; i < rounds; ++i) {
+    v.insert(v.begin() + v.size() / 2, value);
+    v.erase(v.begin() + v.size() / 2);
+  }
+  Timing t = {timer.ns(), 2 * rounds};
+  return t;
+}
+template <template <typename> class Vector, typename Tp>
+Timing range_construct(size_t n) {
+  Vector<Tp> source;
+  fill_vector<Vector, Tp>(source, n);
+  Timer timer;
+  Vector<Tp> v(source.begin(), source.end());
+  Timing t = {timer.ns(), n};
+  return t;
+}
+template <template <typename> class Vector, typename Tp>
+Timing copy_assign(size_t n) {
+  Vector<Tp> source, v;
+  fill_vector<Vector, Tp>(source, n);
+  Timer timer;
+  v = source;
+  Timing t = {timer.ns(), n};
+  return t;
+}
+template <template <typename> class Vector, typename Tp>
+Timing move_assign(size_t n) {
+  Vector<Tp> source, v;
+  fill_vector<Vector, Tp>(source, n);
+  Timer timer;
+  v = std::move(source);
+  Timing t = {timer.ns(), 1};
+  return t;
+}
+template <template <typename> class Vector, typename Tp>
+Timing resize(size_t n) {
+  Vector<Tp> v;
+  Timer timer;
+  v.resize(n);
+  v.resize(n / 2);
+  v.resize(n);
+  Timing t = {timer.ns(), 2 * n};
+  return t;
+}
+template <template <typename> class Vector, typename Tp>
+Timing compare(size_t n) {
+  Vector<Tp> x, y;
+  fill_vector<Vector, Tp>(x, n);
+  fill_vector<Vector, Tp>(y, n);
+  y.back() = make<Tp>(n + 1);
+  Timer timer;
+  volatile bool less = x < y;
+  (void)less;
+  Timing t = {timer.ns(), n};
+  return t;
+}
+// Removes every tenth element in one pass.
+template <typename Tp, typename Predicate>
+void erase_where(MyVector<Tp>& v, Predicate pred) { v.erase_if(pred); }
+template <typename Tp, typename Predicate>
+void erase_where(StdVector<Tp>& v, Predicate pred) {
+  v.erase(std::remove_if(v.begin(), v.end(), pred), v.end());
+}
+template <template <typename> class Vector, typename Tp>
+Timing erase_if(size_t n) {
+  Vector<Tp> v;
+  fill_vector<Vector, Tp>(v, n);
+  size_t i = 0;
+  Timer timer;
+  erase_where(v, [&i](const Tp&) { return i++ % 10 == 0; });
+  Timing t = {timer.ns(), n};
+  return t;
+}
+
+struct Result {
+  double ns_per_op;
+  size_t allocations;
+  long peak_rss_kib;
+};
+
+// Repeats the case until about 10^7 element operations have been timed.
+template <typename Case>
+Result run_case(Case run, size_t n) {
+  int fds[2];
+  if (pipe(fds) != 0) std::abort();
+  pid_t pid = fork();
+  if (pid == 0) {
+    close(fds[0]);
+    double ns = 0;
+    size_t ops = 0, allocations = 0, runs = 0;
+    do {
+      size_t before = allocation_count;
+      Timing t = run(n);
+      allocations += allocation_count - before;
+      ns += t.ns;
+      ops += t.ops;
+      ++runs;
+    } while (ops < 10000000 && ns < 1e9);
+    Result result = {ns / ops, allocations / runs, 0};
+    if (write(fds[1], &result, sizeof(result)) != sizeof(result)) _exit(1);
+    _exit(0);
+  }
+  close(fds[1]);
+  Result result = {0, 0, 0};
+  if (read(fds[0], &result, sizeof(result)) != sizeof(result)) {
+    result.ns_per_op = -1;
+  }
+  close(fds[0]);
+  int status;
+  struct rusage usage;
+  wait4(pid, &status, 0, &usage);
+  result.peak_rss_kib = usage.ru_maxrss;
+  return result;
+}
+
+void compare_case(const char* op, const char* type, size_t n,
+                  Timing (*mine)(size_t), Timing (*theirs)(size_t)) {
+  Result a = run_case(mine, n);
+  Result b = run_case(theirs, n);
+  std::printf("%-18s %-7s %10zu | %10.2f %8zu %9ld | %10.2f %8zu %9ld | "
+              "%5.2f\n", op, type, n, a.ns_per_op, a.allocations,
+              a.peak_rss_kib, b.ns_per_op, b.allocations, b.peak_rss_kib,
+              a.ns_per_op / b.ns_per_op);
+  std::fflush(stdout);
+}
+
+#define BENCH_OP(name)                                                     \
+  template <typename Tp>                                                   \
+  void bench_##name(const char* type, size_t n) {                          \
+    compare_case(#name, type, n, &name<MyVector, Tp>,                      \
+                 &name<StdVector, Tp>);                                    \
+  }
+BENCH_OP(push_back_growth)
+BENCH_OP(reserve_fill)
+BENCH_OP(mid_insert_erase)
+BENCH_OP(range_construct)
+BENCH_OP(copy_assign)
+BENCH_OP(move_assign)
+BENCH_OP(resize)
+BENCH_OP(compare)
+BENCH_OP(erase_if)
+#undef BENCH_OP
+
+typedef void (*BenchFn)(const char*, size_t);
+struct Operation {
+  const char* name;
+  BenchFn int_fn, pod_fn, string_fn, vector_fn;
+};
+#define OPERATION(name)                                                    \
+  { #name, &bench_##name<int>, &bench_##name<Pod64>,                       \
+    &bench_##name<std::string>, &bench_##name<IntVector> }
+static const Operation operations[] = {
+  OPERATION(push_back_growth), OPERATION(reserve_fill),
+  OPERATION(mid_insert_erase), OPERATION(range_construct),
+  OPERATION(copy_assign), OPERATION(move_assign), OPERATION(resize),
+  OPERATION(compare), OPERATION(erase_if),
+};
+#undef OPERATION
+
+int main(int argc, char* argv[]) {
+  size_t max_n = argc > 1 ? std::strtoul(argv[1], 0, 10) : 1000000;
+  const char* only = argc > 2 ? argv[2] : 0;
+  std::printf("%-18s %-7s %10s | %10s %8s %9s | %10s %8s %9s | %5s\n",
+              "operation", "type", "n", "mystl ns", "allocs", "rss KiB",
+              "std ns", "allocs", "rss KiB", "ratio");
+  for (size_t i = 0; i < sizeof(operations) / sizeof(operations[0]); ++i) {
+    const Operation& op = operations[i];
+    if (only != 0 && std::strcmp(only, op.name) != 0) continue;
+    for (size_t n = 10; n <= max_n; n *= 10) {
+      op.int_fn("int", n);
+      op.pod_fn("pod64", n);
+      // 10^8 strings or vectors would need more than 5 GB per vector.
+      if (n <= 10000000) op.string_fn("string", n);
+      if (n <= 10000000) op.vector_fn("vector", n);
+    }
+  }
+}
@@ -0,0 +1,138 @@
+/*
+ * Copyright 2016 Waizung Taam
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ==== vector binary I/O benchmark ==== */
+
+// $ ./vector_io_bench.o [max_elements] [directory]
+//
+// Saves and restores a vector of 64-bit indices through a file:
+// - text:   fprintf() one line per element, fscanf() it back,
+// - binary: write_to() and read_from(),
+// - chunks: vector_reader reading 64K elements at a time into one buffer.
+// The file is freshly written, so reads come from a warm page cache.
+// Best of 5 runs, in milliseconds.
+
+#include "../include/vector_io.h"
+
+#include <fcntl.h>
+#include <inttypes.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+class Timer {
+public:
+  Timer() : begin_(std::chrono::steady_clock::now()) {}
+  double ms() const {
+    return std::chrono::duration<double, std::milli>(
+      std::chrono::steady_clock::now() - begin_).count();
+  }
+private:
+  std::chrono::steady_clock::time_point begin_;
+};
+
+typedef mystl::vector<uint64_t> Index;
+
+double text_save(const std::string& path, const Index& v) {
+  Timer timer;
+  std::FILE* out = std::fopen(path.c_str(), "w");
+  if (out == 0) std::abort();
+  for (size_t i = 0; i < v.size(); ++i) {
+    std::fprintf(out, "%" PRIu64 "\n", v[i]);
+  }
+  std::fclose(out);
+  return timer.ms();
+}
+double text_load(const std::string& path, Index& v) {
+  Timer timer;
+  v.clear();
+  std::FILE* in = std::fopen(path.c_str(), "r");
+  if (in == 0) std::abort();
+  uint64_t x;
+  while (std::fscanf(in, "%" SCNu64, &x) == 1) v.push_back(x);
+  std::fclose(in);
+  return timer.ms();
+}
+double binary_save(const std::string& path, const Index& v) {
+  Timer timer;
+  int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) std::abort();
+  mystl::write_to(fd, v);
+  ::close(fd);
+  return timer.ms();
+}
+double binary_load(const std::string& path, Index& v) {
+  Timer timer;
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) std::abort();
+  mystl::read_from(fd, v);
+  ::close(fd);
+  return timer.ms();
+}
+double chunk_load(const std::string& path, uint64_t& sum) {
+  Timer timer;
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) std::abort();
+  mystl::vector_reader<uint64_t> reader(fd);
+  Index chunk;
+  sum = 0;
+  while (reader.read(chunk, 65536) > 0) {
+    for (size_t i = 0; i < chunk.size(); ++i) sum += chunk[i];
+    chunk.clear();
+  }
+  ::close(fd);
+  return timer.ms();
+}
+
+void keep_best(double& best, double ms, int run) {
+  if (run == 0 || ms < best) best = ms;
+}
+
+void run(const std::string& dir, size_t n) {
+  std::string text = dir + "/vector_io_bench.txt";
+  std::string binary = dir + "/vector_io_bench.bin";
+  Index v;
+  for (size_t i = 0; i < n; ++i) v.push_back(i * 2654435761u % 1000000007);
+  double text_out = 0, text_in = 0, binary_out = 0, binary_in = 0;
+  double chunk_in = 0;
+  for (int r = 0; r < 5; ++r) {
+    Index loaded;
+    keep_best(text_out, text_save(text, v), r);
+    keep_best(text_in, text_load(text, loaded), r);
+    if (loaded != v) std::abort();
+    keep_best(binary_out, binary_save(binary, v), r);
+    keep_best(binary_in, binary_load(binary, loaded), r);
+    if (loaded != v) std::abort();
+    uint64_t sum = 0;
+    keep_best(chunk_in, chunk_load(binary, sum), r);
+  }
+  std::printf("%10zu %8.1f | %10.2f %10.2f | %10.2f %10.2f | %10.2f\n", n,
+              n * sizeof(uint64_t) / 1048576.0, text_out, text_in,
+              binary_out, binary_in, chunk_in);
+  std::remove(text.c_str());
+  std::remove(binary.c_str());
+}
+
+int main(int argc, char* argv[]) {
+  size_t max_n = argc > 1 ? std::strtoul(argv[1], 0, 10) : 10000000;
+  std::string dir = argc > 2 ? argv[2] : ".";
+  std::printf("%10s %8s | %10s %10s | %10s %10s | %10s\n", "n", "MiB",
+              "text out", "text in", "binary out", "binary in",
+              "chunks in");
+  for (size_t n = 1000; n <= max_n; n *= 10) run(dir, n);
+}
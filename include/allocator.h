@@ -0,0 +1,334 @@
+/*
+ * Copyright 2016 Waizung Taam
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ==== Arena and pool allocators ====
+ *
+ * Both allocators are thin handles to a memory resource that outlives
+ * them, so any number of containers can share one resource:
+ *
+ *   mystl::monotonic_arena arena;
+ *   {
+ *     mystl::arena_allocator<int> alloc(&arena);
+ *     mystl::vector<int, mystl::arena_allocator<int>> v(alloc);
+ *     ...
+ *   }
+ *   arena.reset();  // frees every buffer handed out at once
+ *
+ * Like std::pmr allocators, they are not propagated on copy assignment,
+ * move assignment or swap: containers keep the resource they were built
+ * with. A default-constructed allocator has no resource and falls back
+ * to ::operator new and ::operator delete.
+ */
+
+/* - monotonic_arena
+ * - arena_allocator<Tp>
+ * - fixed_pool
+ * - pool_allocator<Tp>
+ */
+#ifndef MYSTL_ALLOCATOR_H
+#define MYSTL_ALLOCATOR_H
+
+#include "vector.h"
+
+namespace mystl {
+
+inline size_t align_up(size_t n, size_t alignment) {
+  return (n + alignment - 1) & ~(alignment - 1);
+}
+
+/* monotonic_arena
+ * Bump-pointer allocation out of a list of chunks. deallocate() only
+ * gives memory back when it is the most recent allocation, such as a
+ * temporary freed before anything else is allocated. A vector that grows
+ * allocates its new buffer before freeing the old one, so the old buffer
+ * is not reclaimed: growing a vector in an arena leaves its earlier
+ * buffers behind, and reserve() avoids that. Everything else is reclaimed
+ * by reset(), which keeps the largest chunk for reuse, or by the
+ * destructor.
+ */
+class monotonic_arena {
+public:
+  explicit monotonic_arena(size_t initial_chunk_size = 4096) :
+    chunks_(0), current_(0), end_(0), last_(0),
+    next_chunk_size_(initial_chunk_size) {}
+  ~monotonic_arena() { release(); }
+
+  void* allocate(size_t bytes, size_t alignment) {
+    char* p = reinterpret_cast<char*>(
+      align_up(reinterpret_cast<size_t>(current_), alignment));
+    if (current_ == 0 || p > end_ || bytes > size_t(end_ - p)) {
+      new_chunk(bytes + alignment);
+      p = reinterpret_cast<char*>(
+        align_up(reinterpret_cast<size_t>(current_), alignment));
+    }
+    last_ = p;
+    current_ = p + bytes;
+    return p;
+  }
+  void deallocate(void* p, size_t bytes) {
+    if (p == last_) {
+      current_ = last_;
+      last_ = 0;
+    }
+  }
+
+  // Invalidates every allocation, keeping the largest chunk.
+  void reset() {
+    chunk* keep = 0;
+    while (chunks_ != 0) {
+      chunk* next = chunks_->next;
+      if (keep == 0 || chunks_->size > keep->size) {
+        if (keep != 0) ::operator delete(keep);
+        keep = chunks_;
+      } else {
+        ::operator delete(chunks_);
+      }
+      chunks_ = next;
+    }
+    chunks_ = keep;
+    if (keep != 0) {
+      keep->next = 0;
+      current_ = reinterpret_cast<char*>(keep + 1);
+      end_ = current_ + keep->size;
+    }
+    last_ = 0;
+  }
+  // Invalidates every allocation and returns all chunks.
+  void release() {
+    while (chunks_ != 0) {
+      chunk* next = chunks_->next;
+      ::operator delete(chunks_);
+      chunks_ = next;
+    }
+    current_ = end_ = last_ = 0;
+  }
+
+private:
+  struct chunk {
+    chunk* next;
+    size_t size;
+  };
+
+  monotonic_arena(const monotonic_arena&);
+  monotonic_arena& operator=(const monotonic_arena&);
+
+  void new_chunk(size_t min_bytes) {
+    size_t size = next_chunk_size_;
+    while (size < min_bytes) size *= 2;
+    next_chunk_size_ = size * 2;
+    chunk* c = static_cast<chunk*>(::operator new(sizeof(chunk) + size));
+    c->next = chunks_;
+    c->size = size;
+    chunks_ = c;
+    current_ = reinterpret_cast<char*>(c + 1);
+    end_ = current_ + size;
+  }
+
+  chunk* chunks_;
+  char* current_;
+  char* end_;
+  char* last_;
+  size_t next_chunk_size_;
+};
+
+template <typename Tp>
+class arena_allocator {
+public:
+  typedef size_t size_type;
+  typedef ptrdiff_t difference_type;
+  typedef Tp value_type;
+  typedef Tp* pointer;
+  typedef const Tp* const_pointer;
+  typedef Tp& reference;
+  typedef const Tp& const_reference;
+
+  template <typename Tp1>
+  struct rebind { typedef arena_allocator<Tp1> other; };
+
+  arena_allocator() : arena_(0) {}
+  explicit arena_allocator(monotonic_arena* arena) : arena_(arena) {}
+  template <typename Tp1>
+  arena_allocator(const arena_allocator<Tp1>& other) :
+    arena_(other.arena()) {}
+
+  size_type max_size() const { return size_type(-1) / sizeof(Tp); }
+  monotonic_arena* arena() const { return arena_; }
+
+  pointer allocate(size_type n, const void* = 0) {
+    if (n > max_size()) throw "Out-of-memory";
+    if (arena_ == 0) {
+      return static_cast<Tp*>(::operator new(n * sizeof(Tp)));
+    }
+    return static_cast<Tp*>(arena_->allocate(n * sizeof(Tp), alignof(Tp)));
+  }
+  void deallocate(pointer p, size_type n) {
+    if (arena_ == 0) {
+      ::operator delete(p);
+    } else {
+      arena_->deallocate(p, n * sizeof(Tp));
+    }
+  }
+
+  template <typename Up, typename... Args>
+  void construct(Up* p, Args&&... args) {
+    ::new((void*)p) Up(mystl::forward<Args>(args)...);
+  }
+  void destroy(pointer p) { p->~Tp(); }
+
+private:
+  monotonic_arena* arena_;
+};
+template <typename Tp1, typename Tp2>
+inline bool operator==(const arena_allocator<Tp1>& x,
+                       const arena_allocator<Tp2>& y) {
+  return x.arena() == y.arena();
+}
+template <typename Tp1, typename Tp2>
+inline bool operator!=(const arena_allocator<Tp1>& x,
+                       const arena_allocator<Tp2>& y) {
+  return !(x == y);
+}
+
+/* fixed_pool
+ * Hands out blocks of one fixed size from a free list. Requests larger
+ * than a block go to ::operator new, so a pool sized for the typical
+ * small buffer serves the bulk of the allocations of many short vectors
+ * and still copes with the odd large one.
+ */
+class fixed_pool {
+public:
+  explicit fixed_pool(size_t block_size, size_t blocks_per_chunk = 64) :
+    block_size_(align_up(block_size < sizeof(void*) ? sizeof(void*) :
+                         block_size, alignof(long double))),
+    blocks_per_chunk_(blocks_per_chunk), free_(0), chunks_(0) {}
+  ~fixed_pool() { release(); }
+
+  size_t block_size() const { return block_size_; }
+
+  void* allocate(size_t bytes) {
+    if (bytes > block_size_) return ::operator new(bytes);
+    if (free_ == 0) new_chunk();
+    block* b = free_;
+    free_ = b->next;
+    return b;
+  }
+  void deallocate(void* p, size_t bytes) {
+    if (p == 0) return;
+    if (bytes > block_size_) {
+      ::operator delete(p);
+      return;
+    }
+    block* b = static_cast<block*>(p);
+    b->next = free_;
+    free_ = b;
+  }
+
+  // Returns all chunks; every block handed out becomes invalid.
+  void release() {
+    while (chunks_ != 0) {
+      block* next = chunks_->next;
+      ::operator delete(chunks_);
+      chunks_ = next;
+    }
+    free_ = 0;
+  }
+
+private:
+  struct block { block* next; };
+
+  fixed_pool(const fixed_pool&);
+  fixed_pool& operator=(const fixed_pool&);
+
+  void new_chunk() {
+    // The first block of every chunk links the chunk list.
+    char* c = static_cast<char*>(
+      ::operator new(block_size_ * (blocks_per_chunk_ + 1)));
+    block* header = reinterpret_cast<block*>(c);
+    header->next = chunks_;
+    chunks_ = header;
+    for (size_t i = blocks_per_chunk_; i > 0; --i) {
+      block* b = reinterpret_cast<block*>(c + i * block_size_);
+      b->next = free_;
+      free_ = b;
+    }
+  }
+
+  size_t block_size_;
+  size_t blocks_per_chunk_;
+  block* free_;
+  block* chunks_;
+};
+
+template <typename Tp>
+class pool_allocator {
+public:
+  typedef size_t size_type;
+  typedef ptrdiff_t difference_type;
+  typedef Tp value_type;
+  typedef Tp* pointer;
+  typedef const Tp* const_pointer;
+  typedef Tp& reference;
+  typedef const Tp& const_reference;
+
+  template <typename Tp1>
+  struct rebind { typedef pool_allocator<Tp1> other; };
+
+  pool_allocator() : pool_(0) {}
+  explicit pool_allocator(fixed_pool* pool) : pool_(pool) {}
+  template <typename Tp1>
+  pool_allocator(const pool_allocator<Tp1>& other) : pool_(other.pool()) {}
+
+  size_type max_size() const { return size_type(-1) / sizeof(Tp); }
+  fixed_pool* pool() const { return pool_; }
+
+  pointer allocate(size_type n, const void* = 0) {
+    if (n > max_size()) throw "Out-of-memory";
+    if (pool_ == 0) {
+      return static_cast<Tp*>(::operator new(n * sizeof(Tp)));
+    }
+    return static_cast<Tp*>(pool_->allocate(n * sizeof(Tp)));
+  }
+  void deallocate(pointer p, size_type n) {
+    if (pool_ == 0) {
+      ::operator delete(p);
+    } else {
+      pool_->deallocate(p, n * sizeof(Tp));
+    }
+  }
+
+  template <typename Up, typename... Args>
+  void construct(Up* p, Args&&... args) {
+    ::new((void*)p) Up(mystl::forward<Args>(args)...);
+  }
+  void destroy(pointer p) { p->~Tp(); }
+
+private:
+  fixed_pool* pool_;
+};
+template <typename Tp1, typename Tp2>
+inline bool operator==(const pool_allocator<Tp1>& x,
+                       const pool_allocator<Tp2>& y) {
+  return x.pool() == y.pool();
+}
+template <typename Tp1, typename Tp2>
+inline bool operator!=(const pool_allocator<Tp1>& x,
+                       const pool_allocator<Tp2>& y) {
+  return !(x == y);
+}
+
+}  // namespace mystl
+
+#endif  // MYSTL_ALLOCATOR_H
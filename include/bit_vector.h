@@ -0,0 +1,688 @@
+/*
+ * Copyright 2016 Waizung Taam
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ==== Bit-packed vector<bool> ====
+ *
+ * Included by vector.h. vector<bool> stores one bit per element in a
+ * vector of 64-bit words, which it uses for allocation and growth, so the
+ * allocator is rebound to the word type.
+ *
+ * As with std::vector<bool>, elements are not objects: operator[] and the
+ * iterators yield bit_reference proxies, data() does not exist, and
+ * words() exposes the packed storage instead.
+ *
+ * Bulk operations work a word at a time: fill(), count(), any(), all(),
+ * find_first(), find_next(), flip(), comparisons and the bitwise
+ * operators between vectors of equal size. Bits of the last word past
+ * size() are kept zero, so that they never need masking.
+ */
+
+/* - bit_reference
+ * - bit_iterator, const_bit_iterator
+ * - fill_bits(), fill() for bit iterators
+ * - vector<bool, Allocator, GrowthPolicy>
+ *   - public
+ *     - ctors, op=, dtor
+ *     - get_allocator()
+ *     - assign()
+ *     - accessors
+ *     - iterators
+ *     - capacity
+ *     - modifiers
+ *     - bulk operations
+ *   - private
+ *     - words_for(), clear_tail()
+ *     - read_bits(), write_bits()
+ *     - copy_bits_forward(), copy_bits_backward()
+ *     - open_gap(), close_gap()
+ *     - range_check(), size_check()
+ *     - data members
+ * - comparisons and bitwise operators of vector<bool>
+ */
+#ifndef MYSTL_BIT_VECTOR_H
+#define MYSTL_BIT_VECTOR_H
+
+#include "vector.h"
+
+namespace mystl {
+
+typedef unsigned long bit_word;
+static const size_t bits_per_word = 8 * sizeof(bit_word);
+
+class bit_reference {
+public:
+  bit_reference(bit_word* word, bit_word mask) : word_(word), mask_(mask) {}
+
+  operator bool() const { return (*word_ & mask_) != 0; }
+  bit_reference& operator=(bool value) {
+    if (value) {
+      *word_ |= mask_;
+    } else {
+      *word_ &= ~mask_;
+    }
+    return *this;
+  }
+  bit_reference& operator=(const bit_reference& other) {
+    return *this = bool(other);
+  }
+  bool operator~() const { return !bool(*this); }
+  void flip() { *word_ ^= mask_; }
+
+private:
+  bit_word* word_;
+  bit_word mask_;
+};
+inline void swap(bit_reference x, bit_reference y) {
+  bool tmp = x;
+  x = y;
+  y = tmp;
+}
+
+/* Bit iterators are a word pointer and a bit offset in [0, 64). */
+template <typename Word>
+class bit_iterator_base {
+public:
+  typedef random_access_iterator_tag iterator_category;
+  typedef bool value_type;
+  typedef ptrdiff_t difference_type;
+  typedef void pointer;
+
+  bit_iterator_base(Word* word, size_t offset) :
+    word_(word), offset_(offset) {}
+
+  Word* word() const { return word_; }
+  size_t offset() const { return offset_; }
+
+  difference_type operator-(const bit_iterator_base& other) const {
+    return (word_ - other.word_) * difference_type(bits_per_word) +
+           difference_type(offset_) - difference_type(other.offset_);
+  }
+  bool operator==(const bit_iterator_base& other) const {
+    return word_ == other.word_ && offset_ == other.offset_;
+  }
+  bool operator!=(const bit_iterator_base& other) const {
+    return !(*this == other);
+  }
+  bool operator<(const bit_iterator_base& other) const {
+    return word_ < other.word_ ||
+           (word_ == other.word_ && offset_ < other.offset_);
+  }
+  bool operator>(const bit_iterator_base& other) const {
+    return other < *this;
+  }
+  bool operator<=(const bit_iterator_base& other) const {
+    return !(other < *this);
+  }
+  bool operator>=(const bit_iterator_base& other) const {
+    return !(*this < other);
+  }
+
+protected:
+  void increment() {
+    if (++offset_ == bits_per_word) {
+      offset_ = 0;
+      ++word_;
+    }
+  }
+  void decrement() {
+    if (offset_-- == 0) {
+      offset_ = bits_per_word - 1;
+      --word_;
+    }
+  }
+  void advance(difference_type n) {
+    difference_type bit = difference_type(offset_) + n;
+    difference_type words = bit >= 0 ? bit / difference_type(bits_per_word) :
+      -((-bit + difference_type(bits_per_word) - 1) /
+        difference_type(bits_per_word));
+    word_ += words;
+    offset_ = size_t(bit - words * difference_type(bits_per_word));
+  }
+
+  Word* word_;
+  size_t offset_;
+};
+
+class bit_iterator : public bit_iterator_base<bit_word> {
+public:
+  typedef bit_reference reference;
+
+  bit_iterator() : bit_iterator_base<bit_word>(0, 0) {}
+  bit_iterator(bit_word* word, size_t offset) :
+    bit_iterator_base<bit_word>(word, offset) {}
+
+  reference operator*() const {
+    return reference(word_, bit_word(1) << offset_);
+  }
+  reference operator[](difference_type n) const { return *(*this + n); }
+
+  bit_iterator& operator++() {
+    increment();
+    return *this;
+  }
+  bit_iterator operator++(int) {
+    bit_iterator tmp = *this;
+    increment();
+    return tmp;
+  }
+  bit_iterator& operator--() {
+    decrement();
+    return *this;
+  }
+  bit_iterator operator--(int) {
+    bit_iterator tmp = *this;
+    decrement();
+    return tmp;
+  }
+  bit_iterator& operator+=(difference_type n) {
+    advance(n);
+    return *this;
+  }
+  bit_iterator& operator-=(difference_type n) {
+    advance(-n);
+    return *this;
+  }
+  bit_iterator operator+(difference_type n) const {
+    bit_iterator tmp = *this;
+    return tmp += n;
+  }
+  bit_iterator operator-(difference_type n) const {
+    bit_iterator tmp = *this;
+    return tmp -= n;
+  }
+  using bit_iterator_base<bit_word>::operator-;
+};
+
+class const_bit_iterator : public bit_iterator_base<const bit_word> {
+public:
+  typedef bool reference;
+
+  const_bit_iterator() : bit_iterator_base<const bit_word>(0, 0) {}
+  const_bit_iterator(const bit_word* word, size_t offset) :
+    bit_iterator_base<const bit_word>(word, offset) {}
+  // bit_iterator -> const_bit_iterator
+  const_bit_iterator(const bit_iterator& other) :
+    bit_iterator_base<const bit_word>(other.word(), other.offset()) {}
+
+  reference operator*() const { return (*word_ >> offset_) & 1; }
+  reference operator[](difference_type n) const { return *(*this + n); }
+
+  const_bit_iterator& operator++() {
+    increment();
+    return *this;
+  }
+  const_bit_iterator operator++(int) {
+    const_bit_iterator tmp = *this;
+    increment();
+    return tmp;
+  }
+  const_bit_iterator& operator--() {
+    decrement();
+    return *this;
+  }
+  const_bit_iterator operator--(int) {
+    const_bit_iterator tmp = *this;
+    decrement();
+    return tmp;
+  }
+  const_bit_iterator& operator+=(difference_type n) {
+    advance(n);
+    return *this;
+  }
+  const_bit_iterator& operator-=(difference_type n) {
+    advance(-n);
+    return *this;
+  }
+  const_bit_iterator operator+(difference_type n) const {
+    const_bit_iterator tmp = *this;
+    return tmp += n;
+  }
+  const_bit_iterator operator-(difference_type n) const {
+    const_bit_iterator tmp = *this;
+    return tmp -= n;
+  }
+  using bit_iterator_base<const bit_word>::operator-;
+};
+
+// Sets or clears n bits from bit offset of *word on, a word at a time.
+inline void fill_bits(bit_word* word, size_t offset, size_t n, bool value) {
+  bit_word pattern = value ? ~bit_word(0) : 0;
+  if (offset != 0 && n != 0) {
+    size_t head = bits_per_word - offset < n ? bits_per_word - offset : n;
+    bit_word mask = (~bit_word(0) >> (bits_per_word - head)) << offset;
+    *word = (*word & ~mask) | (pattern & mask);
+    ++word;
+    n -= head;
+  }
+  for (; n >= bits_per_word; n -= bits_per_word) *word++ = pattern;
+  if (n != 0) {
+    bit_word mask = ~bit_word(0) >> (bits_per_word - n);
+    *word = (*word & ~mask) | (pattern & mask);
+  }
+}
+inline void fill(bit_iterator first, bit_iterator last, const bool& value) {
+  fill_bits(first.word(), first.offset(), size_t(last - first), value);
+}
+
+template <typename Allocator, typename GrowthPolicy>
+class vector<bool, Allocator, GrowthPolicy> {
+  typedef typename Allocator::template rebind<bit_word>::other
+          word_allocator;
+  typedef vector<bit_word, word_allocator, GrowthPolicy> word_vector;
+
+public:
+  typedef size_t size_type;
+  typedef ptrdiff_t difference_type;
+  typedef bool value_type;
+  typedef bit_reference reference;
+  typedef bool const_reference;
+  typedef bit_iterator iterator;
+  typedef const_bit_iterator const_iterator;
+  typedef mystl::reverse_iterator<iterator> reverse_iterator;
+  typedef mystl::reverse_iterator<const_iterator> const_reverse_iterator;
+  typedef Allocator allocator_type;
+  typedef GrowthPolicy growth_policy;
+
+  vector() : size_(0) {}
+  explicit vector(const Allocator& alloc) :
+    words_(word_allocator(alloc)), size_(0) {}
+  explicit vector(size_type n, const bool& value = false,
+                  const Allocator& alloc = Allocator()) :
+    words_(words_for(n), value ? ~bit_word(0) : 0, word_allocator(alloc)),
+    size_(n) {
+    clear_tail();
+  }
+  template <typename InputIterator>
+  vector(InputIterator first, InputIterator last,
+         const Allocator& alloc = Allocator()) :
+    words_(word_allocator(alloc)), size_(0) {
+    assign_aux(first, last, typename is_integral<InputIterator>::type());
+  }
+  vector(const vector& other) : words_(other.words_), size_(other.size_) {}
+  vector(vector&& other) noexcept :
+    words_(mystl::move(other.words_)), size_(other.size_) {
+    other.size_ = 0;
+  }
+  ~vector() {}
+
+  vector& operator=(const vector& other) {
+    words_ = other.words_;
+    size_ = other.size_;
+    return *this;
+  }
+  vector& operator=(vector&& other) {
+    if (this != &other) {
+      words_ = mystl::move(other.words_);
+      size_ = other.size_;
+      other.words_.clear();
+      other.size_ = 0;
+    }
+    return *this;
+  }
+
+  allocator_type get_allocator() const {
+    return allocator_type(words_.get_allocator());
+  }
+
+  void assign(size_type n, const bool& value) {
+    words_.assign(words_for(n), value ? ~bit_word(0) : 0);
+    size_ = n;
+    clear_tail();
+  }
+  template <typename InputIterator>
+  void assign(InputIterator first, InputIterator last) {
+    clear();
+    assign_aux(first, last, typename is_integral<InputIterator>::type());
+  }
+
+  /* accessors */
+  reference operator[](size_type pos) {
+    return reference(&words_[pos / bits_per_word],
+                     bit_word(1) << (pos % bits_per_word));
+  }
+  const_reference operator[](size_type pos) const {
+    return (words_[pos / bits_per_word] >> (pos % bits_per_word)) & 1;
+  }
+  reference at(size_type pos) {
+    range_check(pos);
+    return (*this)[pos];
+  }
+  const_reference at(size_type pos) const {
+    range_check(pos);
+    return (*this)[pos];
+  }
+  reference front() { return (*this)[0]; }
+  const_reference front() const { return (*this)[0]; }
+  reference back() { return (*this)[size_ - 1]; }
+  const_reference back() const { return (*this)[size_ - 1]; }
+  // The packed storage: bit i is bit i % 64 of word i / 64.
+  bit_word* words() { return words_.data(); }
+  const bit_word* words() const { return words_.data(); }
+  size_type word_count() const { return words_.size(); }
+
+  /* iterators */
+  iterator begin() { return iterator(words_.data(), 0); }
+  const_iterator begin() const { return const_iterator(words_.data(), 0); }
+  const_iterator cbegin() const { return begin(); }
+  iterator end() { return begin() + difference_type(size_); }
+  const_iterator end() const { return begin() + difference_type(size_); }
+  const_iterator cend() const { return end(); }
+  reverse_iterator rbegin() { return reverse_iterator(end()); }
+  const_reverse_iterator rbegin() const {
+    return const_reverse_iterator(end());
+  }
+  const_reverse_iterator crbegin() const { return rbegin(); }
+  reverse_iterator rend() { return reverse_iterator(begin()); }
+  const_reverse_iterator rend() const {
+    return const_reverse_iterator(begin());
+  }
+  const_reverse_iterator crend() const { return rend(); }
+
+  /* capacity */
+  size_type size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  size_type max_size() const {
+    size_type words = words_.max_size();
+    return words > size_type(-1) / bits_per_word ? size_type(-1)
+                                                 : words * bits_per_word;
+  }
+  size_type capacity() const { return words_.capacity() * bits_per_word; }
+  void reserve(size_type n) { words_.reserve(words_for(n)); }
+  void shrink_to_fit() { words_.shrink_to_fit(); }
+
+  /* modifiers */
+  void push_back(bool value) {
+    if (size_ % bits_per_word == 0) words_.push_back(0);
+    if (value) {
+      words_[size_ / bits_per_word] |= bit_word(1) << (size_ % bits_per_word);
+    }
+    ++size_;
+  }
+  void pop_back() {
+    --size_;
+    if (size_ % bits_per_word == 0) {
+      words_.pop_back();
+    } else {
+      words_[size_ / bits_per_word] &=
+        ~(bit_word(1) << (size_ % bits_per_word));
+    }
+  }
+  void clear() {
+    words_.clear();
+    size_ = 0;
+  }
+  void resize(size_type n, bool value = false) {
+    size_type old_size = size_;
+    words_.resize(words_for(n), 0);
+    size_ = n;
+    if (n < old_size) {
+      clear_tail();
+    } else if (value) {
+      fill(old_size, n - old_size, true);
+    }
+  }
+  iterator insert(const_iterator pos, bool value) {
+    return insert(pos, 1, value);
+  }
+  iterator insert(const_iterator pos, size_type n, bool value) {
+    size_type index = size_type(pos - cbegin());
+    open_gap(index, n);
+    fill(index, n, value);
+    return begin() + difference_type(index);
+  }
+  template <typename InputIterator>
+  iterator insert(const_iterator pos, InputIterator first,
+                  InputIterator last) {
+    size_type index = size_type(pos - cbegin());
+    vector bits(first, last);
+    open_gap(index, bits.size());
+    copy_bits_forward(bits, 0, index, bits.size());
+    return begin() + difference_type(index);
+  }
+  iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+  iterator erase(const_iterator first, const_iterator last) {
+    size_type index = size_type(first - cbegin());
+    close_gap(index, size_type(last - first));
+    return begin() + difference_type(index);
+  }
+  void swap(vector& other) {
+    words_.swap(other.words_);
+    mystl::swap(size_, other.size_);
+  }
+  static void swap(reference x, reference y) { mystl::swap(x, y); }
+
+  /* bulk operations */
+  void flip() {
+    for (size_type i = 0; i < words_.size(); ++i) words_[i] = ~words_[i];
+    clear_tail();
+  }
+  void fill(bool value) { fill(0, size_, value); }
+  void fill(size_type pos, size_type n, bool value) {
+    fill_bits(words_.data() + pos / bits_per_word, pos % bits_per_word, n,
+              value);
+  }
+  // Number of set bits.
+  size_type count() const {
+    size_type n = 0;
+    for (size_type i = 0; i < words_.size(); ++i) {
+      n += __builtin_popcountl(words_[i]);
+    }
+    return n;
+  }
+  bool any() const {
+    for (size_type i = 0; i < words_.size(); ++i) {
+      if (words_[i] != 0) return true;
+    }
+    return false;
+  }
+  bool none() const { return !any(); }
+  bool all() const { return count() == size_; }
+  // Index of the first set bit, or size() if there is none.
+  size_type find_first() const { return find_from(0); }
+  // Index of the first set bit after pos, or size() if there is none.
+  size_type find_next(size_type pos) const { return find_from(pos + 1); }
+
+  vector& operator&=(const vector& other) {
+    size_check(other);
+    for (size_type i = 0; i < words_.size(); ++i) words_[i] &= other.words_[i];
+    return *this;
+  }
+  vector& operator|=(const vector& other) {
+    size_check(other);
+    for (size_type i = 0; i < words_.size(); ++i) words_[i] |= other.words_[i];
+    return *this;
+  }
+  vector& operator^=(const vector& other) {
+    size_check(other);
+    for (size_type i = 0; i < words_.size(); ++i) words_[i] ^= other.words_[i];
+    return *this;
+  }
+
+private:
+  static size_type words_for(size_type n) {
+    return (n + bits_per_word - 1) / bits_per_word;
+  }
+  void clear_tail() {
+    if (size_ % bits_per_word != 0) {
+      words_.back() &= 
+        ~bit_word(0) >> (bits_per_word - size_ % bits_per_word);
+    }
+  }
+  template <typename Integral>
+  void assign_aux(Integral n, Integral value, true_type) {
+    assign(size_type(n), bool(value));
+  }
+  template <typename InputIterator>
+  void assign_aux(InputIterator first, InputIterator last, false_type) {
+    for (; first != last; ++first) push_back(bool(*first));
+  }
+
+  size_type find_from(size_type pos) const {
+    if (pos >= size_) return size_;
+    size_type i = pos / bits_per_word;
+    bit_word word = words_[i] & (~bit_word(0) << (pos % bits_per_word));
+    while (word == 0) {
+      if (++i == words_.size()) return size_;
+      word = words_[i];
+    }
+    return i * bits_per_word + __builtin_ctzl(word);
+  }
+
+  /* Bit ranges are moved 64 bits at a time: read_bits() gathers up to a
+   * word's worth of bits from any bit position, write_bits() scatters
+   * them back.
+   */
+  static bit_word read_bits(const bit_word* words, size_type pos,
+                            size_type n) {
+    size_type i = pos / bits_per_word, offset = pos % bits_per_word;
+    bit_word value = words[i] >> offset;
+    if (offset != 0 && offset + n > bits_per_word) {
+      value |= words[i + 1] << (bits_per_word - offset);
+    }
+    return n == bits_per_word ? value :
+           value & (~bit_word(0) >> (bits_per_word - n));
+  }
+  static void write_bits(bit_word* words, size_type pos, bit_word value,
+                         size_type n) {
+    size_type i = pos / bits_per_word, offset = pos % bits_per_word;
+    bit_word mask = n == bits_per_word ? ~bit_word(0) :
+                    ~bit_word(0) >> (bits_per_word - n);
+    words[i] = (words[i] & ~(mask << offset)) | (value << offset);
+    if (offset != 0 && offset + n > bits_per_word) {
+      size_type shift = bits_per_word - offset;
+      words[i + 1] = (words[i + 1] & ~(mask >> shift)) | (value >> shift);
+    }
+  }
+  // Copies n bits from source bit from to bit to; from > to if aliased.
+  void copy_bits_forward(const vector& source, size_type from, size_type to,
+                         size_type n) {
+    for (size_type done = 0; done < n; done += bits_per_word) {
+      size_type m = n - done < bits_per_word ? n - done : bits_per_word;
+      write_bits(words_.data(), to + done,
+                 read_bits(source.words_.data(), from + done, m), m);
+    }
+  }
+  // Copies n bits of this vector from bit from to bit to > from.
+  void copy_bits_backward(size_type from, size_type to, size_type n) {
+    while (n > 0) {
+      size_type m = n < bits_per_word ? n : bits_per_word;
+      n -= m;
+      write_bits(words_.data(), to + n,
+                 read_bits(words_.data(), from + n, m), m);
+    }
+  }
+  // Makes room for n bits at pos; their values are unspecified.
+  void open_gap(size_type pos, size_type n) {
+    words_.resize(words_for(size_ + n), 0);
+    copy_bits_backward(pos, pos + n, size_ - pos);
+    size_ += n;
+  }
+  void close_gap(size_type pos, size_type n) {
+    copy_bits_forward(*this, pos + n, pos, size_ - pos - n);
+    size_ -= n;
+    words_.resize(words_for(size_));
+    clear_tail();
+  }
+
+  void range_check(size_type pos) const {
+    if (pos >= size_) throw "Out-of-range";
+  }
+  void size_check(const vector& other) const {
+    if (size_ != other.size_) throw "Size-mismatch";
+  }
+
+  word_vector words_;
+  size_type size_;
+};
+
+/* Whole words compare like the bits they hold: equal words mean equal
+ * bits, and the lowest differing bit of the first differing word decides
+ * the order, since it comes first.
+ */
+template <typename Allocator, typename GrowthPolicy>
+bool operator==(const vector<bool, Allocator, GrowthPolicy>& x,
+                const vector<bool, Allocator, GrowthPolicy>& y) {
+  return x.size() == y.size() &&
+         mystl::equal_aux(x.words(), y.words(), x.word_count(), true_type());
+}
+template <typename Allocator, typename GrowthPolicy>
+bool operator<(const vector<bool, Allocator, GrowthPolicy>& x,
+               const vector<bool, Allocator, GrowthPolicy>& y) {
+  size_t n = x.size() < y.size() ? x.size() : y.size();
+  for (size_t i = 0; i * bits_per_word < n; ++i) {
+    bit_word diff = x.words()[i] ^ y.words()[i];
+    if (diff != 0) {
+      size_t bit = i * bits_per_word + __builtin_ctzl(diff);
+      // A difference past n is only the zero tail of the shorter one.
+      if (bit >= n) break;
+      return y[bit];
+    }
+  }
+  return x.size() < y.size();
+}
+template <typename Allocator, typename GrowthPolicy>
+bool operator!=(const vector<bool, Allocator, GrowthPolicy>& x,
+                const vector<bool, Allocator, GrowthPolicy>& y) {
+  return !(x == y);
+}
+template <typename Allocator, typename GrowthPolicy>
+bool operator>(const vector<bool, Allocator, GrowthPolicy>& x,
+               const vector<bool, Allocator, GrowthPolicy>& y) {
+  return y < x;
+}
+template <typename Allocator, typename GrowthPolicy>
+bool operator<=(const vector<bool, Allocator, GrowthPolicy>& x,
+                const vector<bool, Allocator, GrowthPolicy>& y) {
+  return !(y < x);
+}
+template <typename Allocator, typename GrowthPolicy>
+bool operator>=(const vector<bool, Allocator, GrowthPolicy>& x,
+                const vector<bool, Allocator, GrowthPolicy>& y) {
+  return !(x < y);
+}
+
+template <typename Allocator, typename GrowthPolicy>
+vector<bool, Allocator, GrowthPolicy> operator&(
+    const vector<bool, Allocator, GrowthPolicy>& x,
+    const vector<bool, Allocator, GrowthPolicy>& y) {
+  vector<bool, Allocator, GrowthPolicy> result(x);
+  return result &= y;
+}
+template <typename Allocator, typename GrowthPolicy>
+vector<bool, Allocator, GrowthPolicy> operator|(
+    const vector<bool, Allocator, GrowthPolicy>& x,
+    const vector<bool, Allocator, GrowthPolicy>& y) {
+  vector<bool, Allocator, GrowthPolicy> result(x);
+  return result |= y;
+}
+template <typename Allocator, typename GrowthPolicy>
+vector<bool, Allocator, GrowthPolicy> operator^(
+    const vector<bool, Allocator, GrowthPolicy>& x,
+    const vector<bool, Allocator, GrowthPolicy>& y) {
+  vector<bool, Allocator, GrowthPolicy> result(x);
+  return result ^= y;
+}
+template <typename Allocator, typename GrowthPolicy>
+vector<bool, Allocator, GrowthPolicy> operator~(
+    const vector<bool, Allocator, GrowthPolicy>& x) {
+  vector<bool, Allocator, GrowthPolicy> result(x);
+  result.flip();
+  return result;
+}
+
+}  // namespace mystl
+
+#endif  // MYSTL_BIT_VECTOR_H
@@ -0,0 +1,316 @@
+/*
+ * Copyright 2016 Waizung Taam
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ==== Concurrent append-only vector ====
+ *
+ * concurrent_vector<Tp> lets any number of threads append at the same
+ * time without a lock, and read elements by index while others append:
+ *
+ *   mystl::concurrent_vector<Record> records;
+ *   // on every worker thread
+ *   records.push_back(record);
+ *   // once the workers have joined
+ *   mystl::vector<Record> all = records.compact();
+ *
+ * Elements live in a segment table (see segment_table.h). Appending claims
+ * indices with one atomic add and never moves an element, so references
+ * and indices stay valid until clear() or compact().
+ *
+ * Thread safety:
+ * - push_back(), emplace_back(), grow_by(), reserve(), operator[], at(),
+ *   size() and capacity() may be called concurrently with each other.
+ * - An element may only be read once the thread that appended it has
+ *   published its index, e.g. through the value returned by grow_by() and
+ *   a later synchronization. size() counts claimed indices, including
+ *   elements still being constructed by other threads.
+ * - Iterators, clear(), compact() and destruction require that no other
+ *   thread uses the vector.
+ * - The allocator must be safe to call from several threads.
+ *
+ * Since a claimed index cannot be given back, the elements are built
+ * before their index is claimed where possible: emplace_back() constructs
+ * a temporary and moves it into place, so Tp must be nothrow move
+ * constructible. Copies made by grow_by() and a failure to allocate a
+ * segment cannot be undone and terminate the program.
+ */
+
+/* - concurrent_vector<Tp, Allocator>
+ *   - public
+ *     - ctors, dtor
+ *     - get_allocator()
+ *     - accessors
+ *     - iterators
+ *     - capacity
+ *     - push_back(), emplace_back(), grow_by()
+ *     - clear(), compact()
+ *   - private
+ *     - grow_by_aux()
+ *     - claim(), segment(), prefetch_segment()
+ *     - fill_claimed(), copy_claimed()
+ *     - compact_segment()
+ *     - release()
+ *     - data members
+ */
+#ifndef MYSTL_CONCURRENT_VECTOR_H
+#define MYSTL_CONCURRENT_VECTOR_H
+
+#include "segment_table.h"
+
+namespace mystl {
+
+template <typename Tp, typename Allocator = new_allocator<Tp>>
+class concurrent_vector {
+  // 32 elements in the first segment, then doubling.
+  typedef segment_layout<5> layout;
+
+public:
+  typedef Tp value_type;
+  typedef Allocator allocator_type;
+  typedef size_t size_type;
+  typedef ptrdiff_t difference_type;
+  typedef Tp& reference;
+  typedef const Tp& const_reference;
+  typedef Tp* pointer;
+  typedef const Tp* const_pointer;
+  typedef segment_iterator<Tp, Tp&, Tp*, 5> iterator;
+  typedef segment_iterator<Tp, const Tp&, const Tp*, 5> const_iterator;
+
+  static_assert(is_nothrow_move_constructible<Tp>::value,
+                "concurrent_vector requires a nothrow move constructor");
+
+  explicit concurrent_vector(const Allocator& alloc = Allocator()) :
+    allocator_(alloc), size_(0) {
+    for (size_type k = 0; k < layout::max_segments; ++k) segments_[k] = 0;
+  }
+  ~concurrent_vector() {
+    clear();
+    release();
+  }
+
+  allocator_type get_allocator() const { return allocator_; }
+
+  /* accessors */
+  reference operator[](size_type pos) {
+    size_type k = layout::segment_of(pos);
+    return __atomic_load_n(&segments_[k], __ATOMIC_ACQUIRE)
+      [pos - layout::segment_begin(k)];
+  }
+  const_reference operator[](size_type pos) const {
+    size_type k = layout::segment_of(pos);
+    return __atomic_load_n(&segments_[k], __ATOMIC_ACQUIRE)
+      [pos - layout::segment_begin(k)];
+  }
+  reference at(size_type pos) {
+    if (pos >= size()) throw "Out-of-range";
+    return (*this)[pos];
+  }
+  const_reference at(size_type pos) const {
+    if (pos >= size()) throw "Out-of-range";
+    return (*this)[pos];
+  }
+
+  /* iterators */
+  iterator begin() { return iterator(segments_, 0); }
+  const_iterator begin() const { return const_iterator(segments_, 0); }
+  const_iterator cbegin() const { return begin(); }
+  iterator end() { return iterator(segments_, size()); }
+  const_iterator end() const { return const_iterator(segments_, size()); }
+  const_iterator cend() const { return end(); }
+
+  /* capacity */
+  size_type size() const {
+    return __atomic_load_n(&size_, __ATOMIC_ACQUIRE);
+  }
+  bool empty() const { return size() == 0; }
+  size_type max_size() const {
+    return layout::capacity_of(layout::max_segments);
+  }
+  // Elements that fit in the leading run of allocated segments.
+  size_type capacity() const {
+    size_type k = 0;
+    while (k < layout::max_segments &&
+           __atomic_load_n(&segments_[k], __ATOMIC_ACQUIRE) != 0) {
+      ++k;
+    }
+    return layout::capacity_of(k);
+  }
+  // Allocates the segments for the first n elements.
+  void reserve(size_type n) {
+    if (n > max_size()) throw "Out-of-memory";
+    for (size_type k = 0; k < layout::segments_for(n); ++k) segment(k);
+  }
+
+  /* appending
+   * Each returns the element or the index of the first element appended.
+   */
+  reference push_back(const Tp& value) { return emplace_back(value); }
+  reference push_back(Tp&& value) {
+    return emplace_back(mystl::move(value));
+  }
+  template <typename... Args>
+  reference emplace_back(Args&&... args) {
+    Tp value(mystl::forward<Args>(args)...);
+    size_type pos = claim(1);
+    size_type k = layout::segment_of(pos);
+    prefetch_segment(pos, 1);
+    Tp* p = segment(k) + (pos - layout::segment_begin(k));
+    allocator_.construct(p, mystl::move(value));
+    return *p;
+  }
+  // Appends n value-initialized elements.
+  size_type grow_by(size_type n) {
+    return grow_by(n, Tp());
+  }
+  size_type grow_by(size_type n, const Tp& value) {
+    size_type pos = claim(n);
+    fill_claimed(pos, n, value);
+    return pos;
+  }
+  template <typename ForwardIterator>
+  size_type grow_by(ForwardIterator first, ForwardIterator last) {
+    return grow_by_aux(first, last,
+                       typename is_integral<ForwardIterator>::type());
+  }
+
+  /* single-threaded */
+  // Destroys the elements and keeps the segments for reuse.
+  void clear() {
+    size_type n = size();
+    for (size_type k = 0, done = 0; done < n; ++k) {
+      size_type m = layout::segment_size(k) < n - done ?
+                    layout::segment_size(k) : n - done;
+      for (Tp* p = segments_[k]; p != segments_[k] + m; ++p) {
+        allocator_.destroy(p);
+      }
+      done += m;
+    }
+    size_ = 0;
+  }
+  // Moves the elements into one contiguous vector and clears this one.
+  vector<Tp, Allocator> compact() {
+    vector<Tp, Allocator> result(allocator_);
+    size_type n = size();
+    result.reserve(n);
+    for (size_type k = 0, done = 0; done < n; ++k) {
+      size_type m = layout::segment_size(k) < n - done ?
+                    layout::segment_size(k) : n - done;
+      compact_segment(result, segments_[k], m,
+                      typename is_trivially_copyable<Tp>::type());
+      done += m;
+    }
+    clear();
+    return result;
+  }
+
+private:
+  concurrent_vector(const concurrent_vector&);
+  concurrent_vector& operator=(const concurrent_vector&);
+
+  template <typename Integral>
+  size_type grow_by_aux(Integral n, Integral value, true_type) {
+    return grow_by(size_type(n), Tp(value));
+  }
+  template <typename ForwardIterator>
+  size_type grow_by_aux(ForwardIterator first, ForwardIterator last,
+                        false_type) {
+    size_type n = size_type(mystl::distance(first, last));
+    size_type pos = claim(n);
+    copy_claimed(pos, n, first);
+    return pos;
+  }
+  size_type claim(size_type n) {
+    return __atomic_fetch_add(&size_, n, __ATOMIC_RELAXED);
+  }
+  /* Returns segment k, allocating it if no other thread has. Threads that
+   * race on the same segment each allocate one and all but the winner of
+   * the compare-and-swap give theirs back; to make that rare, the thread
+   * that claims the middle of segment k allocates segment k + 1 ahead.
+   */
+  Tp* segment(size_type k) noexcept {
+    Tp* s = __atomic_load_n(&segments_[k], __ATOMIC_ACQUIRE);
+    if (s != 0) return s;
+    Tp* fresh = allocator_.allocate(layout::segment_size(k));
+    if (__atomic_compare_exchange_n(&segments_[k], &s, fresh, false,
+                                    __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+      return fresh;
+    }
+    allocator_.deallocate(fresh, layout::segment_size(k));
+    return s;
+  }
+  void prefetch_segment(size_type first, size_type n) noexcept {
+    size_type k = layout::segment_of(first);
+    size_type middle = layout::segment_begin(k) + layout::segment_size(k) / 2;
+    if (first <= middle && middle < first + n &&
+        k + 1 < layout::max_segments) {
+      segment(k + 1);
+    }
+  }
+  void fill_claimed(size_type pos, size_type n, const Tp& value) noexcept {
+    while (n > 0) {
+      size_type k = layout::segment_of(pos);
+      size_type offset = pos - layout::segment_begin(k);
+      size_type m = layout::segment_size(k) - offset < n ?
+                    layout::segment_size(k) - offset : n;
+      prefetch_segment(pos, m);
+      mystl::uninitialized_fill_n(segment(k) + offset, m, value);
+      pos += m;
+      n -= m;
+    }
+  }
+  template <typename ForwardIterator>
+  void copy_claimed(size_type pos, size_type n,
+                    ForwardIterator first) noexcept {
+    while (n > 0) {
+      size_type k = layout::segment_of(pos);
+      size_type offset = pos - layout::segment_begin(k);
+      size_type m = layout::segment_size(k) - offset < n ?
+                    layout::segment_size(k) - offset : n;
+      ForwardIterator next = first;
+      mystl::advance(next, m);
+      prefetch_segment(pos, m);
+      mystl::uninitialized_copy(first, next, segment(k) + offset);
+      first = next;
+      pos += m;
+      n -= m;
+    }
+  }
+  void compact_segment(vector<Tp, Allocator>& result, Tp* p, size_type n,
+                       true_type) {
+    result.append(p, n);
+  }
+  void compact_segment(vector<Tp, Allocator>& result, Tp* p, size_type n,
+                       false_type) {
+    for (Tp* last = p + n; p != last; ++p) {
+      result.push_back(mystl::move(*p));
+    }
+  }
+  void release() {
+    for (size_type k = 0; k < layout::max_segments; ++k) {
+      if (segments_[k] != 0) {
+        allocator_.deallocate(segments_[k], layout::segment_size(k));
+        segments_[k] = 0;
+      }
+    }
+  }
+
+  Allocator allocator_;
+  Tp* segments_[layout::max_segments];
+  size_type size_;
+};
+
+}  // namespace mystl
+
+#endif  // MYSTL_CONCURRENT_VECTOR_H
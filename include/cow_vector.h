@@ -0,0 +1,420 @@
+/*
+ * Copyright 2016 Waizung Taam
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ==== Copy-on-write vector ====
+ *
+ * cow_vector<Tp> has the interface and iterator types of vector, but its
+ * copies share one reference-counted buffer until one of them is
+ * modified, which then copies the elements for itself. Handing the same
+ * table to many readers costs one atomic increment per copy:
+ *
+ *   mystl::cow_vector<Route> routes = load_routes();
+ *   for (size_t i = 0; i < workers.size(); ++i) {
+ *     workers[i].routes = routes;       // no element is copied
+ *   }
+ *
+ * Reading through a const cow_vector (operator[], at(), data(), begin()
+ * of a const object, or cbegin()) never copies. The non-const versions
+ * of those, and insert(), erase() and emplace(), hand out a pointer into
+ * the buffer, so they first make it exclusive and then mark this vector
+ * unshareable: later copies of it copy the elements, so writes through a
+ * reference taken earlier are never seen by a copy. Assigning a new
+ * value makes the vector shareable again. Modifiers that return no
+ * reference, such as push_back(), keep the vector shareable.
+ *
+ * Copies of one cow_vector may be used by different threads at the same
+ * time: the reference count is atomic, and a buffer is only modified in
+ * place by its sole owner. As with vector, one cow_vector object must
+ * not be used by several threads at once if any of them modifies it.
+ *
+ * Only cow_vectors with equal allocators share a buffer. Allocators are
+ * not propagated on assignment: assigning from a vector with an unequal
+ * allocator copies (or, from an rvalue, moves) the elements into a
+ * buffer of this one's allocator. swap() requires equal allocators.
+ */
+
+/* - cow_vector<Tp, Allocator, GrowthPolicy>
+ *   - public
+ *     - ctors, op=, dtor
+ *     - get_allocator()
+ *     - assign()
+ *     - accessors
+ *     - iterators
+ *     - capacity
+ *     - modifiers
+ *     - use_count()
+ *   - private
+ *     - shared_buffer
+ *     - share(), release(), make_buffer()
+ *     - copy_buffer(), move_buffer()
+ *     - mutate(), expose()
+ *     - data members
+ * - is_trivially_relocatable<cow_vector>
+ * - comparisons of cow_vectors
+ */
+#ifndef MYSTL_COW_VECTOR_H
+#define MYSTL_COW_VECTOR_H
+
+#include "vector.h"
+
+namespace mystl {
+
+template <typename Tp, typename Allocator = new_allocator<Tp>,
+          typename GrowthPolicy = double_growth>
+class cow_vector {
+public:
+  typedef vector<Tp, Allocator, GrowthPolicy> vector_type;
+  typedef typename vector_type::size_type size_type;
+  typedef typename vector_type::difference_type difference_type;
+  typedef typename vector_type::value_type value_type;
+  typedef typename vector_type::pointer pointer;
+  typedef typename vector_type::const_pointer const_pointer;
+  typedef typename vector_type::reference reference;
+  typedef typename vector_type::const_reference const_reference;
+  typedef typename vector_type::iterator iterator;
+  typedef typename vector_type::const_iterator const_iterator;
+  typedef typename vector_type::reverse_iterator reverse_iterator;
+  typedef typename vector_type::const_reverse_iterator
+    const_reverse_iterator;
+  typedef Allocator allocator_type;
+  typedef GrowthPolicy growth_policy;
+
+  /* ctors, op=, dtor
+   * An empty cow_vector has no buffer, so default construction and
+   * moves never allocate.
+   */
+  cow_vector() : buffer_(0), shareable_(true), allocator_(Allocator()) {}
+  explicit cow_vector(const Allocator& alloc) :
+    buffer_(0), shareable_(true), allocator_(alloc) {}
+  explicit cow_vector(size_type n, const Allocator& alloc = Allocator()) :
+    buffer_(0), shareable_(true), allocator_(alloc) {
+    buffer_ = make_buffer(vector_type(n, alloc));
+  }
+  cow_vector(size_type n, const Tp& value,
+             const Allocator& alloc = Allocator()) :
+    buffer_(0), shareable_(true), allocator_(alloc) {
+    buffer_ = make_buffer(vector_type(n, value, alloc));
+  }
+  template <typename InputIterator>
+  cow_vector(InputIterator first, InputIterator last,
+             const Allocator& alloc = Allocator()) :
+    buffer_(0), shareable_(true), allocator_(alloc) {
+    buffer_ = make_buffer(vector_type(first, last, alloc));
+  }
+  cow_vector(const vector_type& items) :
+    buffer_(0), shareable_(true), allocator_(items.get_allocator()) {
+    buffer_ = make_buffer(vector_type(items));
+  }
+  // Takes over the buffer of a vector without copying it.
+  cow_vector(vector_type&& items) :
+    buffer_(0), shareable_(true), allocator_(items.get_allocator()) {
+    buffer_ = make_buffer(mystl::move(items));
+  }
+  cow_vector(const cow_vector& other) :
+    buffer_(0), shareable_(true), allocator_(other.allocator_) {
+    buffer_ = other.share();
+  }
+  cow_vector(cow_vector&& other) noexcept :
+    buffer_(other.buffer_), shareable_(other.shareable_),
+    allocator_(other.allocator_) {
+    other.buffer_ = 0;
+    other.shareable_ = true;
+  }
+
+  cow_vector& operator=(const cow_vector& other) {
+    if (&other != this) {
+      shared_buffer* buffer = allocator_ == other.allocator_ ?
+                              other.share() : copy_buffer(other);
+      release();
+      buffer_ = buffer;
+      shareable_ = true;
+    }
+    return *this;
+  }
+  cow_vector& operator=(cow_vector&& other) {
+    if (&other != this && allocator_ == other.allocator_) {
+      release();
+      buffer_ = other.buffer_;
+      shareable_ = other.shareable_;
+      other.buffer_ = 0;
+      other.shareable_ = true;
+    } else if (&other != this) {
+      shared_buffer* buffer = move_buffer(other);
+      release();
+      buffer_ = buffer;
+      shareable_ = true;
+      other.release();
+    }
+    return *this;
+  }
+
+  ~cow_vector() { release(); }
+
+  allocator_type get_allocator() const { return allocator_; }
+
+  void assign(size_type n, const Tp& value) {
+    *this = cow_vector(n, value, allocator_);
+  }
+  template <typename InputIterator>
+  void assign(InputIterator first, InputIterator last) {
+    *this = cow_vector(first, last, allocator_);
+  }
+
+  /* accessors */
+  reference operator[](size_type pos) { return expose()[pos]; }
+  const_reference operator[](size_type pos) const { return data()[pos]; }
+  reference at(size_type pos) { return expose().at(pos); }
+  const_reference at(size_type pos) const {
+    if (pos >= size()) throw "Out-of-range";
+    return data()[pos];
+  }
+  reference front() { return expose().front(); }
+  const_reference front() const { return data()[0]; }
+  reference back() { return expose().back(); }
+  const_reference back() const { return data()[size() - 1]; }
+  pointer data() { return expose().data(); }
+  const_pointer data() const { return buffer_ ? buffer_->items.data() : 0; }
+
+  /* iterators */
+  iterator begin() { return expose().begin(); }
+  const_iterator begin() const { return data(); }
+  const_iterator cbegin() const { return data(); }
+  iterator end() { return expose().end(); }
+  const_iterator end() const { return data() + size(); }
+  const_iterator cend() const { return end(); }
+  reverse_iterator rbegin() { return reverse_iterator(end()); }
+  const_reverse_iterator rbegin() const {
+    return const_reverse_iterator(end());
+  }
+  const_reverse_iterator crbegin() const { return rbegin(); }
+  reverse_iterator rend() { return reverse_iterator(begin()); }
+  const_reverse_iterator rend() const {
+    return const_reverse_iterator(begin());
+  }
+  const_reverse_iterator crend() const { return rend(); }
+
+  /* capacity */
+  size_type size() const { return buffer_ ? buffer_->items.size() : 0; }
+  size_type max_size() const { return size_type(-1) / sizeof(Tp); }
+  size_type capacity() const {
+    return buffer_ ? buffer_->items.capacity() : 0;
+  }
+  bool empty() const { return size() == 0; }
+  void reserve(size_type n) {
+    if (n > capacity()) mutate().reserve(n);
+  }
+  void shrink_to_fit() {
+    if (capacity() > size()) mutate().shrink_to_fit();
+  }
+
+  /* modifiers
+   * Positions are turned into indices before the buffer is made
+   * exclusive, since that may move the elements.
+   */
+  void push_back(const Tp& value) { mutate().push_back(value); }
+  void push_back(Tp&& value) { mutate().push_back(mystl::move(value)); }
+  template <typename... Args>
+  void emplace_back(Args&&... args) {
+    mutate().emplace_back(mystl::forward<Args>(args)...);
+  }
+  void pop_back() { mutate().pop_back(); }
+  iterator insert(const_iterator pos, const Tp& value) {
+    size_type i = pos - cbegin();
+    vector_type& v = expose();
+    return v.insert(v.begin() + i, value);
+  }
+  iterator insert(const_iterator pos, Tp&& value) {
+    size_type i = pos - cbegin();
+    vector_type& v = expose();
+    return v.insert(v.begin() + i, mystl::move(value));
+  }
+  iterator insert(const_iterator pos, size_type n, const Tp& value) {
+    size_type i = pos - cbegin();
+    vector_type& v = expose();
+    return v.insert(v.begin() + i, n, value);
+  }
+  template <typename InputIterator>
+  iterator insert(const_iterator pos, InputIterator first,
+                  InputIterator last) {
+    size_type i = pos - cbegin();
+    vector_type& v = expose();
+    return v.insert(v.begin() + i, first, last);
+  }
+  template <typename... Args>
+  iterator emplace(const_iterator pos, Args&&... args) {
+    size_type i = pos - cbegin();
+    vector_type& v = expose();
+    return v.emplace(v.begin() + i, mystl::forward<Args>(args)...);
+  }
+  iterator erase(const_iterator pos) {
+    size_type i = pos - cbegin();
+    vector_type& v = expose();
+    return v.erase(v.begin() + i);
+  }
+  iterator erase(const_iterator first, const_iterator last) {
+    size_type i = first - cbegin(), j = last - cbegin();
+    vector_type& v = expose();
+    return v.erase(v.begin() + i, v.begin() + j);
+  }
+  // Drops a shared buffer instead of copying it just to empty it.
+  void clear() {
+    if (buffer_ != 0 &&
+        __atomic_load_n(&buffer_->refs, __ATOMIC_ACQUIRE) != 1) {
+      release();
+    } else if (buffer_ != 0) {
+      buffer_->items.clear();
+    }
+  }
+  void resize(size_type n) {
+    if (n != size()) mutate().resize(n);
+  }
+  void resize(size_type n, const Tp& value) {
+    if (n != size()) mutate().resize(n, value);
+  }
+  void swap(cow_vector& other) {
+    mystl::swap(buffer_, other.buffer_);
+    mystl::swap(shareable_, other.shareable_);
+  }
+
+  // The number of cow_vectors sharing this one's buffer, 0 if it has none.
+  size_type use_count() const {
+    return buffer_ ? __atomic_load_n(&buffer_->refs, __ATOMIC_ACQUIRE) : 0;
+  }
+
+private:
+  struct shared_buffer {
+    explicit shared_buffer(vector_type&& v) :
+      refs(1), items(mystl::move(v)) {}
+    size_type refs;
+    vector_type items;
+  };
+  typedef typename Allocator::template rebind<shared_buffer>::other
+    buffer_allocator;
+
+  // Returns the buffer for a new copy of this vector, adding a reference.
+  shared_buffer* share() const {
+    if (buffer_ == 0) return 0;
+    if (!shareable_) return make_buffer(vector_type(buffer_->items));
+    __atomic_fetch_add(&buffer_->refs, 1, __ATOMIC_RELAXED);
+    return buffer_;
+  }
+  void release() {
+    if (buffer_ != 0 &&
+        __atomic_fetch_sub(&buffer_->refs, 1, __ATOMIC_ACQ_REL) == 1) {
+      buffer_allocator alloc(allocator_);
+      alloc.destroy(buffer_);
+      alloc.deallocate(buffer_, 1);
+    }
+    buffer_ = 0;
+    shareable_ = true;
+  }
+  shared_buffer* make_buffer(vector_type&& items) const {
+    buffer_allocator alloc(allocator_);
+    shared_buffer* buffer = alloc.allocate(1);
+    ::new(static_cast<void*>(buffer)) shared_buffer(mystl::move(items));
+    return buffer;
+  }
+  /* Return a buffer of this vector's allocator holding the elements of
+   * other, whose allocator is unequal. move_buffer() moves them if other
+   * owns its buffer alone, and copies them otherwise.
+   */
+  shared_buffer* copy_buffer(const cow_vector& other) const {
+    if (other.buffer_ == 0) return 0;
+    return make_buffer(vector_type(other.data(), other.data() + other.size(),
+                                   allocator_));
+  }
+  shared_buffer* move_buffer(cow_vector& other) const {
+    if (other.buffer_ == 0 ||
+        __atomic_load_n(&other.buffer_->refs, __ATOMIC_ACQUIRE) != 1) {
+      return copy_buffer(other);
+    }
+    vector_type& from = other.buffer_->items;
+    vector_type items(allocator_);
+    items.reserve(from.size());
+    for (size_type i = 0; i < from.size(); ++i) {
+      items.push_back(mystl::move(from[i]));
+    }
+    return make_buffer(mystl::move(items));
+  }
+
+  /* Returns the elements for writing, copying them first if shared. An
+   * unshareable vector never shares its buffer, so it is not copied.
+   */
+  vector_type& mutate() {
+    if (buffer_ == 0) {
+      buffer_ = make_buffer(vector_type(allocator_));
+    } else if (__atomic_load_n(&buffer_->refs, __ATOMIC_ACQUIRE) != 1) {
+      shared_buffer* copy = make_buffer(vector_type(buffer_->items));
+      release();
+      buffer_ = copy;
+    }
+    return buffer_->items;
+  }
+  // Like mutate(), for callers that hand out pointers into the buffer.
+  vector_type& expose() {
+    vector_type& items = mutate();
+    shareable_ = false;
+    return items;
+  }
+
+  shared_buffer* buffer_;
+  bool shareable_;
+  Allocator allocator_;
+};
+
+// Like a vector, a cow_vector refers to its buffer only by pointer.
+template <typename Tp, typename Allocator, typename GrowthPolicy>
+struct is_trivially_relocatable<cow_vector<Tp, Allocator, GrowthPolicy>> :
+  is_trivially_relocatable<Allocator> {};
+
+template <typename Tp, typename Allocator, typename GrowthPolicy>
+bool operator==(const cow_vector<Tp, Allocator, GrowthPolicy>& x,
+                const cow_vector<Tp, Allocator, GrowthPolicy>& y) {
+  if (x.size() != y.size()) return false;
+  if (x.data() == y.data()) return true;
+  return mystl::equal_aux(x.data(), y.data(), x.size(),
+                          typename is_integral<Tp>::type());
+}
+template <typename Tp, typename Allocator, typename GrowthPolicy>
+bool operator<(const cow_vector<Tp, Allocator, GrowthPolicy>& x,
+               const cow_vector<Tp, Allocator, GrowthPolicy>& y) {
+  return mystl::less_aux(x.data(), x.size(), y.data(), y.size(),
+                         typename is_integral<Tp>::type());
+}
+template <typename Tp, typename Allocator, typename GrowthPolicy>
+bool operator!=(const cow_vector<Tp, Allocator, GrowthPolicy>& x,
+                const cow_vector<Tp, Allocator, GrowthPolicy>& y) {
+  return !(x == y);
+}
+template <typename Tp, typename Allocator, typename GrowthPolicy>
+bool operator>(const cow_vector<Tp, Allocator, GrowthPolicy>& x,
+               const cow_vector<Tp, Allocator, GrowthPolicy>& y) {
+  return y < x;
+}
+template <typename Tp, typename Allocator, typename GrowthPolicy>
+bool operator<=(const cow_vector<Tp, Allocator, GrowthPolicy>& x,
+                const cow_vector<Tp, Allocator, GrowthPolicy>& y) {
+  return !(y < x);
+}
+template <typename Tp, typename Allocator, typename GrowthPolicy>
+bool operator>=(const cow_vector<Tp, Allocator, GrowthPolicy>& x,
+                const cow_vector<Tp, Allocator, GrowthPolicy>& y) {
+  return !(x < y);
+}
+
+}  // namespace mystl
+
+#endif  // MYSTL_COW_VECTOR_H
@@ -0,0 +1,98 @@
+/*
+ * Copyright 2016 Waizung Taam
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ==== Map in a sorted vector ====
+ *
+ * flat_map<Key, Tp> keeps pair<Key, Tp> elements sorted by key in one
+ * mystl::vector, with the lookups, bulk insertion and optional Eytzinger
+ * index of sorted_vector.h:
+ *
+ *   mystl::flat_map<int, Route> routes;
+ *   routes.insert_sorted(table.begin(), table.end());
+ *   routes.build_index();
+ *   Route& r = routes.at(prefix);
+ *
+ * Iterators are pointers to the pairs. The values may be modified
+ * through them, the keys must not be: unlike std::map the key is not
+ * const, so that the elements can be shifted by assignment.
+ */
+
+/* - flat_map<Key, Tp, Compare, Allocator>
+ *   - ctors
+ *   - operator[], at()
+ */
+#ifndef MYSTL_FLAT_MAP_H
+#define MYSTL_FLAT_MAP_H
+
+#include "sorted_vector.h"
+
+namespace mystl {
+
+template <typename Key, typename Tp, typename Compare = less<Key>,
+          typename Allocator = new_allocator<pair<Key, Tp>>>
+class flat_map :
+  public sorted_vector<pair<Key, Tp>, Key, select_first, Compare, Allocator,
+                       true> {
+  typedef sorted_vector<pair<Key, Tp>, Key, select_first, Compare,
+                        Allocator, true> base;
+public:
+  typedef Tp mapped_type;
+  typedef typename base::vector_type vector_type;
+  typedef typename base::size_type size_type;
+  typedef typename base::value_type value_type;
+
+  explicit flat_map(const Compare& comp = Compare(),
+                    const Allocator& alloc = Allocator()) :
+    base(comp, alloc) {}
+  template <typename InputIterator>
+  flat_map(InputIterator first, InputIterator last,
+           const Compare& comp = Compare(),
+           const Allocator& alloc = Allocator()) :
+    base(comp, alloc) {
+    this->insert(first, last);
+  }
+  // Adopts pairs that are already sorted by key and unique, without
+  // copying.
+  flat_map(sorted_unique_t tag, vector_type&& items,
+           const Compare& comp = Compare()) :
+    base(tag, mystl::move(items), comp) {}
+
+  // Inserts a value-initialized Tp if key is absent.
+  Tp& operator[](const Key& key) {
+    size_type pos = this->lower_bound_index(key);
+    if (pos == this->size() ||
+        this->comp_(key, this->items_[pos].first)) {
+      this->index_.clear();
+      this->items_.insert(this->items_.begin() + pos,
+                          value_type(key, Tp()));
+    }
+    return this->items_[pos].second;
+  }
+  Tp& at(const Key& key) {
+    size_type pos = this->find_index(key);
+    if (pos == this->size()) throw "Out-of-range";
+    return this->items_[pos].second;
+  }
+  const Tp& at(const Key& key) const {
+    size_type pos = this->find_index(key);
+    if (pos == this->size()) throw "Out-of-range";
+    return this->items_[pos].second;
+  }
+};
+
+}  // namespace mystl
+
+#endif  // MYSTL_FLAT_MAP_H
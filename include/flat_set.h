@@ -0,0 +1,71 @@
+/*
+ * Copyright 2016 Waizung Taam
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ==== Set in a sorted vector ====
+ *
+ * flat_set<Key> keeps its keys sorted in one mystl::vector: lookups are
+ * binary searches over contiguous memory, and the set costs no more
+ * memory than its keys. Insertion and erasure are linear, so build it in
+ * bulk where possible:
+ *
+ *   mystl::flat_set<int> ids;
+ *   ids.insert(batch.begin(), batch.end());  // sorted and merged once
+ *   ids.build_index();                       // for a read-only phase
+ *   if (ids.contains(id)) ...
+ *
+ * Iterators are const pointers and, like references, are invalidated by
+ * any insertion or erasure. See sorted_vector.h for the lookup and merge
+ * strategies.
+ */
+
+/* - flat_set<Key, Compare, Allocator>
+ *   - ctors
+ */
+#ifndef MYSTL_FLAT_SET_H
+#define MYSTL_FLAT_SET_H
+
+#include "sorted_vector.h"
+
+namespace mystl {
+
+template <typename Key, typename Compare = less<Key>,
+          typename Allocator = new_allocator<Key>>
+class flat_set :
+  public sorted_vector<Key, Key, identity_key, Compare, Allocator, false> {
+  typedef sorted_vector<Key, Key, identity_key, Compare, Allocator, false>
+          base;
+public:
+  typedef typename base::vector_type vector_type;
+
+  explicit flat_set(const Compare& comp = Compare(),
+                    const Allocator& alloc = Allocator()) :
+    base(comp, alloc) {}
+  template <typename InputIterator>
+  flat_set(InputIterator first, InputIterator last,
+           const Compare& comp = Compare(),
+           const Allocator& alloc = Allocator()) :
+    base(comp, alloc) {
+    this->insert(first, last);
+  }
+  // Adopts keys that are already sorted and unique, without copying.
+  flat_set(sorted_unique_t tag, vector_type&& keys,
+           const Compare& comp = Compare()) :
+    base(tag, mystl::move(keys), comp) {}
+};
+
+}  // namespace mystl
+
+#endif  // MYSTL_FLAT_SET_H
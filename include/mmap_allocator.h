@@ -0,0 +1,400 @@
+/*
+ * Copyright 2016 Waizung Taam
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ==== Memory-mapped allocator and file-backed vector ====
+ *
+ * mmap_allocator<Tp> hands out buffers mapped with mmap() and resizes them
+ * with mremap(), which vector uses through the reallocate() hook for
+ * trivially relocatable elements: growing never copies the elements, the
+ * kernel moves page table entries instead.
+ *
+ * Given a mapped_file, the allocator maps that file instead of anonymous
+ * memory, so the vector contents live in the file. mmap_vector<Tp> wraps
+ * the two and reopens an existing file with its stored size in O(1), the
+ * page cache reading the data lazily on first access:
+ *
+ *   {
+ *     mystl::mmap_vector<Point> points("points.vec");
+ *     points.push_back(p);
+ *   }                                   // size written back to the file
+ *   mystl::mmap_vector<Point> points("points.vec");  // points.size() == 1
+ *
+ * A file holds a single buffer, so one vector at a time may use it. The
+ * file starts with one page of header, followed by the elements:
+ *
+ *   offset 0     mapped_file_header (magic, version, element size, size,
+ *                capacity)
+ *   offset 4096  capacity elements
+ *
+ * The layout is the in-memory representation of Tp, so a file is only
+ * portable between builds with the same ABI.
+ *
+ * large_buffer_allocator<Tp> uses ::operator new for small buffers and
+ * mappings for large ones, for vectors that grow to gigabytes.
+ *
+ * Linux only (mremap).
+ */
+
+/* - mapped_file_header
+ * - mapped_file
+ * - mmap_allocator<Tp>
+ * - large_buffer_allocator<Tp, Threshold>
+ * - mmap_vector<Tp, GrowthPolicy>
+ */
+#ifndef MYSTL_MMAP_ALLOCATOR_H
+#define MYSTL_MMAP_ALLOCATOR_H
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "vector.h"
+
+namespace mystl {
+
+struct mapped_file_header {
+  char magic[8];
+  unsigned version;
+  unsigned element_size;
+  size_t size;
+  size_t capacity;
+};
+
+/* mapped_file
+ * Keeps the file mapped from the header to the end of the buffer. The
+ * buffer is handed to one allocator at a time; deallocate() returns it
+ * to the file without discarding its contents.
+ */
+class mapped_file {
+public:
+  static const size_t header_size = 4096;
+  static const unsigned version = 1;
+
+  // Opens path, creating it if it does not exist.
+  mapped_file(const char* path, size_t element_size) :
+    fd_(-1), base_(0), mapped_(0), element_size_(element_size),
+    in_use_(false) {
+    fd_ = ::open(path, O_RDWR | O_CREAT, 0644);
+    if (fd_ < 0) throw "mapped_file: cannot open file";
+    struct stat st;
+    if (::fstat(fd_, &st) != 0) {
+      ::close(fd_);
+      throw "mapped_file: cannot stat file";
+    }
+    size_t bytes = st.st_size;
+    bool created = bytes == 0;
+    if (created) {
+      bytes = header_size;
+      if (::ftruncate(fd_, bytes) != 0) {
+        ::close(fd_);
+        throw "mapped_file: cannot resize file";
+      }
+    }
+    if (bytes < header_size) {
+      ::close(fd_);
+      throw "mapped_file: not a vector file";
+    }
+    base_ = ::mmap(0, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (base_ == MAP_FAILED) {
+      ::close(fd_);
+      throw "mapped_file: mmap failed";
+    }
+    mapped_ = bytes;
+    if (created) {
+      __builtin_memcpy(header()->magic, "mystlvec", 8);
+      header()->version = version;
+      header()->element_size = element_size;
+      header()->size = 0;
+      header()->capacity = 0;
+    } else if (__builtin_memcmp(header()->magic, "mystlvec", 8) != 0 ||
+               header()->version != version ||
+               header()->element_size != element_size ||
+               header()->capacity > (bytes - header_size) / element_size ||
+               header()->size > header()->capacity) {
+      ::munmap(base_, mapped_);
+      ::close(fd_);
+      throw "mapped_file: not a vector file of this element type";
+    }
+  }
+  ~mapped_file() {
+    ::munmap(base_, mapped_);
+    ::close(fd_);
+  }
+
+  void* data() const { return static_cast<char*>(base_) + header_size; }
+  size_t capacity() const { return header()->capacity; }
+  // The number of elements, as last recorded by set_size().
+  size_t size() const { return header()->size; }
+  void set_size(size_t n) { header()->size = n; }
+
+  // Hands out the buffer with its current contents.
+  void* acquire() {
+    if (in_use_) throw "mapped_file: buffer already in use";
+    in_use_ = true;
+    return data();
+  }
+  void* allocate(size_t bytes) {
+    acquire();
+    return resize(bytes);
+  }
+  void deallocate() { in_use_ = false; }
+  // Grows or shrinks the buffer, keeping its contents.
+  void* resize(size_t bytes) {
+    size_t file_bytes = header_size + bytes;
+    if (::ftruncate(fd_, file_bytes) != 0) {
+      throw "mapped_file: cannot resize file";
+    }
+    void* p = ::mremap(base_, mapped_, file_bytes, MREMAP_MAYMOVE);
+    if (p == MAP_FAILED) throw "mapped_file: mremap failed";
+    base_ = p;
+    mapped_ = file_bytes;
+    header()->capacity = bytes / element_size_;
+    if (header()->size > header()->capacity) {
+      header()->size = header()->capacity;
+    }
+    return data();
+  }
+  // Flushes the header and the elements to disk.
+  void sync() { ::msync(base_, mapped_, MS_SYNC); }
+
+private:
+  mapped_file(const mapped_file&);
+  mapped_file& operator=(const mapped_file&);
+
+  mapped_file_header* header() const {
+    return static_cast<mapped_file_header*>(base_);
+  }
+
+  int fd_;
+  void* base_;
+  size_t mapped_;
+  size_t element_size_;
+  bool in_use_;
+};
+
+template <typename Tp>
+class mmap_allocator {
+public:
+  typedef size_t size_type;
+  typedef ptrdiff_t difference_type;
+  typedef Tp value_type;
+  typedef Tp* pointer;
+  typedef const Tp* const_pointer;
+  typedef Tp& reference;
+  typedef const Tp& const_reference;
+
+  template <typename Tp1>
+  struct rebind { typedef mmap_allocator<Tp1> other; };
+
+  // Without a file, buffers are private anonymous mappings.
+  mmap_allocator() : file_(0) {}
+  explicit mmap_allocator(mapped_file* file) : file_(file) {}
+  template <typename Tp1>
+  mmap_allocator(const mmap_allocator<Tp1>& other) : file_(other.file()) {}
+
+  size_type max_size() const { return size_type(-1) / sizeof(Tp); }
+  mapped_file* file() const { return file_; }
+
+  pointer allocate(size_type n, const void* = 0) {
+    if (n > max_size()) throw "Out-of-memory";
+    if (file_ != 0) return static_cast<Tp*>(file_->allocate(n * sizeof(Tp)));
+    if (n == 0) return 0;
+    void* p = ::mmap(0, n * sizeof(Tp), PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED) throw "Out-of-memory";
+    return static_cast<Tp*>(p);
+  }
+  void deallocate(pointer p, size_type n) {
+    if (file_ != 0) {
+      if (p != 0) file_->deallocate();
+    } else if (p != 0) {
+      ::munmap(p, n * sizeof(Tp));
+    }
+  }
+  // mremap() keeps the whole mapping, so used does not matter.
+  pointer reallocate(pointer p, size_type old_n, size_type new_n,
+                     size_type used) {
+    if (p == 0) return allocate(new_n);
+    if (new_n > max_size()) throw "Out-of-memory";
+    if (file_ != 0) return static_cast<Tp*>(file_->resize(new_n * sizeof(Tp)));
+    if (new_n == 0) {
+      deallocate(p, old_n);
+      return 0;
+    }
+    void* q = ::mremap(p, old_n * sizeof(Tp), new_n * sizeof(Tp),
+                       MREMAP_MAYMOVE);
+    if (q == MAP_FAILED) throw "Out-of-memory";
+    return static_cast<Tp*>(q);
+  }
+  bool expand_in_place(pointer p, size_type old_n, size_type new_n) {
+    if (file_ != 0 || p == 0 || new_n > max_size()) return false;
+    return ::mremap(p, old_n * sizeof(Tp), new_n * sizeof(Tp), 0) != 
+           MAP_FAILED;
+  }
+
+  template <typename Up, typename... Args>
+  void construct(Up* p, Args&&... args) {
+    ::new((void*)p) Up(mystl::forward<Args>(args)...);
+  }
+  void destroy(pointer p) { p->~Tp(); }
+
+private:
+  mapped_file* file_;
+};
+template <typename Tp1, typename Tp2>
+inline bool operator==(const mmap_allocator<Tp1>& x,
+                       const mmap_allocator<Tp2>& y) {
+  return x.file() == y.file();
+}
+template <typename Tp1, typename Tp2>
+inline bool operator!=(const mmap_allocator<Tp1>& x,
+                       const mmap_allocator<Tp2>& y) {
+  return !(x == y);
+}
+
+/* large_buffer_allocator
+ * Takes buffers below Threshold bytes from ::operator new and maps larger
+ * ones, so that growing a large vector is an mremap(): trivially
+ * relocatable elements are never copied, and for other types the buffer
+ * is extended in place whenever the address space behind it is free.
+ * Large mappings are advised to use transparent huge pages.
+ */
+template <typename Tp, size_t Threshold = (size_t(1) << 20)>
+class large_buffer_allocator {
+public:
+  typedef size_t size_type;
+  typedef ptrdiff_t difference_type;
+  typedef Tp value_type;
+  typedef Tp* pointer;
+  typedef const Tp* const_pointer;
+  typedef Tp& reference;
+  typedef const Tp& const_reference;
+
+  template <typename Tp1>
+  struct rebind { typedef large_buffer_allocator<Tp1, Threshold> other; };
+
+  large_buffer_allocator() {}
+  template <typename Tp1>
+  large_buffer_allocator(const large_buffer_allocator<Tp1, Threshold>&) {}
+
+  size_type max_size() const { return size_type(-1) / sizeof(Tp); }
+
+  pointer allocate(size_type n, const void* = 0) {
+    if (n > max_size()) throw "Out-of-memory";
+    if (!is_large(n)) return static_cast<Tp*>(::operator new(n * sizeof(Tp)));
+    void* p = ::mmap(0, n * sizeof(Tp), PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED) throw "Out-of-memory";
+    ::madvise(p, n * sizeof(Tp), MADV_HUGEPAGE);
+    return static_cast<Tp*>(p);
+  }
+  void deallocate(pointer p, size_type n) {
+    if (p == 0) return;
+    if (is_large(n)) {
+      ::munmap(p, n * sizeof(Tp));
+    } else {
+      ::operator delete(p);
+    }
+  }
+  pointer reallocate(pointer p, size_type old_n, size_type new_n,
+                     size_type used) {
+    if (p == 0) return allocate(new_n);
+    if (new_n > max_size()) throw "Out-of-memory";
+    if (is_large(old_n) && is_large(new_n)) {
+      void* q = ::mremap(p, old_n * sizeof(Tp), new_n * sizeof(Tp),
+                         MREMAP_MAYMOVE);
+      if (q == MAP_FAILED) throw "Out-of-memory";
+      ::madvise(q, new_n * sizeof(Tp), MADV_HUGEPAGE);
+      return static_cast<Tp*>(q);
+    }
+    // Crossing the threshold: copy only the elements in use.
+    pointer q = allocate(new_n);
+    if (used > new_n) used = new_n;
+    if (used != 0) __builtin_memcpy(q, p, used * sizeof(Tp));
+    deallocate(p, old_n);
+    return q;
+  }
+  bool expand_in_place(pointer p, size_type old_n, size_type new_n) {
+    if (p == 0 || !is_large(old_n) || new_n > max_size()) return false;
+    return ::mremap(p, old_n * sizeof(Tp), new_n * sizeof(Tp), 0) != 
+           MAP_FAILED;
+  }
+
+  template <typename Up, typename... Args>
+  void construct(Up* p, Args&&... args) {
+    ::new((void*)p) Up(mystl::forward<Args>(args)...);
+  }
+  void destroy(pointer p) { p->~Tp(); }
+
+private:
+  static bool is_large(size_type n) { return n * sizeof(Tp) >= Threshold; }
+};
+template <typename Tp1, typename Tp2, size_t Threshold>
+inline bool operator==(const large_buffer_allocator<Tp1, Threshold>&,
+                       const large_buffer_allocator<Tp2, Threshold>&) {
+  return true;
+}
+template <typename Tp1, typename Tp2, size_t Threshold>
+inline bool operator!=(const large_buffer_allocator<Tp1, Threshold>&,
+                       const large_buffer_allocator<Tp2, Threshold>&) {
+  return false;
+}
+
+// Constructs the file before, and closes it after, the vector base.
+class mapped_file_holder {
+protected:
+  mapped_file_holder(const char* path, size_t element_size) :
+    file_(path, element_size) {}
+  mapped_file file_;
+};
+
+/* mmap_vector
+ * A vector whose elements live in a file. Opening the file adopts the
+ * stored elements; sync() and the destructor record size() in the header
+ * so that the next open sees them.
+ */
+template <typename Tp, typename GrowthPolicy = double_growth>
+class mmap_vector : private mapped_file_holder,
+                    public vector<Tp, mmap_allocator<Tp>, GrowthPolicy> {
+  typedef vector<Tp, mmap_allocator<Tp>, GrowthPolicy> base;
+  static_assert(is_trivially_copyable<Tp>::value,
+                "mmap_vector requires a trivially copyable element type");
+public:
+  explicit mmap_vector(const char* path) :
+    mapped_file_holder(path, sizeof(Tp)),
+    base(mmap_allocator<Tp>(&this->file_)) {
+    if (file_.capacity() != 0) {
+      this->start_ = static_cast<Tp*>(file_.acquire());
+      this->finish_ = this->start_ + file_.size();
+      this->end_of_storage_ = this->start_ + file_.capacity();
+    }
+  }
+  ~mmap_vector() { file_.set_size(this->size()); }
+
+  void sync() {
+    file_.set_size(this->size());
+    file_.sync();
+  }
+
+private:
+  mmap_vector(const mmap_vector&);
+  mmap_vector& operator=(const mmap_vector&);
+};
+
+}  // namespace mystl
+
+#endif  // MYSTL_MMAP_ALLOCATOR_H
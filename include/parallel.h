@@ -0,0 +1,426 @@
+/*
+ * Copyright 2016 Waizung Taam
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ==== Parallel algorithms over contiguous ranges ====
+ *
+ * The algorithms take a parallel_policy, naming a thread_pool and the size
+ * in bytes below which they run serially on the calling thread:
+ *
+ *   mystl::parallel_policy par;
+ *   mystl::parallel_fill(par, v.begin(), v.end(), 1L);
+ *   long sum = mystl::parallel_reduce(par, v.data(), v.data() + v.size(),
+ *     0L, [](long x, long y) { return x + y; });
+ *
+ * A range is cut into one chunk per thread, chunk boundaries rounded to
+ * page addresses, and chunk i always goes to thread i of the pool. Buffers that
+ * parallel_vector fills on construction are therefore first touched, and
+ * placed on the NUMA node of, the thread that later works on them.
+ *
+ * Element operations must not throw: an exception escaping a pool thread
+ * terminates the program.
+ */
+
+/* - thread_pool
+ * - parallel_policy
+ * - parallel_fill(), parallel_uninitialized_fill_n()
+ * - parallel_copy(), parallel_uninitialized_copy()
+ * - parallel_transform()
+ * - parallel_reduce()
+ * - parallel_vector<Tp, Allocator, GrowthPolicy>
+ */
+#ifndef MYSTL_PARALLEL_H
+#define MYSTL_PARALLEL_H
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "vector.h"
+
+namespace mystl {
+
+/* thread_pool
+ * run(task) calls task(i, n) once for every i in [0, n), n being
+ * concurrency(): i = 0 on the calling thread, i > 0 on worker i - 1. It
+ * returns when all calls have returned.
+ *
+ * run() may be called from several threads at once, as every default
+ * parallel_policy shares global(): the calls take turns, each waiting
+ * for the previous one to finish. A task must not call run() on its own
+ * pool, which would wait for itself.
+ */
+class thread_pool {
+public:
+  // 0 threads means one per hardware thread, the caller included.
+  explicit thread_pool(unsigned threads = 0) :
+    task_(0), context_(0), generation_(0), pending_(0), stop_(false) {
+    if (threads == 0) threads = std::thread::hardware_concurrency();
+    if (threads == 0) threads = 1;
+    workers_ = new std::thread[threads - 1];
+    worker_count_ = threads - 1;
+    for (unsigned i = 0; i < worker_count_; ++i) {
+      workers_[i] = std::thread(&thread_pool::work, this, i + 1);
+    }
+  }
+  ~thread_pool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    start_.notify_all();
+    for (unsigned i = 0; i < worker_count_; ++i) workers_[i].join();
+    delete[] workers_;
+  }
+
+  unsigned concurrency() const { return worker_count_ + 1; }
+
+  template <typename Task>
+  void run(const Task& task) {
+    if (worker_count_ == 0) {
+      task(0u, 1u);
+      return;
+    }
+    std::lock_guard<std::mutex> turn(run_mutex_);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      task_ = &invoke<Task>;
+      context_ = &task;
+      pending_ = worker_count_;
+      ++generation_;
+    }
+    start_.notify_all();
+    task(0u, concurrency());
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (pending_ != 0) done_.wait(lock);
+  }
+
+  // A pool with one thread per hardware thread, created on first use.
+  static thread_pool& global() {
+    static thread_pool pool;
+    return pool;
+  }
+
+private:
+  typedef void (*task_type)(const void*, unsigned, unsigned);
+
+  thread_pool(const thread_pool&);
+  thread_pool& operator=(const thread_pool&);
+
+  template <typename Task>
+  static void invoke(const void* context, unsigned i, unsigned n) {
+    (*static_cast<const Task*>(context))(i, n);
+  }
+  void work(unsigned index) {
+    unsigned long seen = 0;
+    for (;;) {
+      task_type task;
+      const void* context;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!stop_ && generation_ == seen) start_.wait(lock);
+        if (stop_) return;
+        seen = generation_;
+        task = task_;
+        context = context_;
+      }
+      task(context, index, concurrency());
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (--pending_ == 0) done_.notify_one();
+    }
+  }
+
+  std::thread* workers_;
+  unsigned worker_count_;
+  std::mutex run_mutex_;  // held for a whole run()
+  std::mutex mutex_;
+  std::condition_variable start_;
+  std::condition_variable done_;
+  task_type task_;
+  const void* context_;
+  unsigned long generation_;
+  unsigned pending_;
+  bool stop_;
+};
+
+struct parallel_policy {
+  // A null pool means thread_pool::global().
+  explicit parallel_policy(thread_pool* pool = 0,
+                           size_t serial_threshold = size_t(1) << 18) :
+    pool_(pool), serial_threshold_(serial_threshold) {}
+
+  thread_pool& pool() const {
+    return pool_ != 0 ? *pool_ : thread_pool::global();
+  }
+  // Whether n elements of size bytes are worth splitting across threads.
+  bool serial(size_t n, size_t size) const {
+    return n * size < serial_threshold_;
+  }
+
+  thread_pool* pool_;
+  size_t serial_threshold_;
+};
+
+/* Chunk i of n over the count elements at data. Inner boundaries are
+ * moved up to the next element that starts a page, when elements tile
+ * pages from some point of data on, so that no page is first touched by
+ * two threads.
+ */
+template <typename Tp>
+inline size_t parallel_boundary(const Tp* data, size_t count, size_t step,
+                                unsigned i) {
+  size_t k = step * i;
+  if (i == 0 || k >= count) return i == 0 ? 0 : count;
+  size_t to_page = (4096 - reinterpret_cast<size_t>(data) % 4096) % 4096;
+  if (4096 % sizeof(Tp) == 0 && to_page % sizeof(Tp) == 0) {
+    size_t page = 4096 / sizeof(Tp);
+    size_t head = to_page / sizeof(Tp);  // elements before the first page
+    k = k <= head ? head : head + (k - head + page - 1) / page * page;
+  }
+  return k < count ? k : count;
+}
+template <typename Tp>
+inline void parallel_chunk(const Tp* data, size_t count, unsigned i,
+                           unsigned n, size_t* begin, size_t* end) {
+  size_t step = (count + n - 1) / n;
+  *begin = parallel_boundary(data, count, step, i);
+  *end = parallel_boundary(data, count, step, i + 1);
+}
+
+/* Each algorithm packs its arguments into a task run by the pool. */
+template <typename Tp>
+struct fill_task {
+  Tp* first;
+  size_t n;
+  const Tp* value;
+  bool uninitialized;
+  void operator()(unsigned i, unsigned threads) const {
+    size_t begin, end;
+    parallel_chunk(first, n, i, threads, &begin, &end);
+    if (uninitialized) {
+      mystl::uninitialized_fill_n(first + begin, end - begin, *value);
+    } else {
+      mystl::fill_n(first + begin, end - begin, *value);
+    }
+  }
+};
+template <typename Tp>
+struct copy_task {
+  const Tp* first;
+  size_t n;
+  Tp* result;
+  bool uninitialized;
+  void operator()(unsigned i, unsigned threads) const {
+    size_t begin, end;
+    parallel_chunk(result, n, i, threads, &begin, &end);
+    if (uninitialized) {
+      mystl::uninitialized_copy(first + begin, first + end, result + begin);
+    } else {
+      mystl::copy(first + begin, first + end, result + begin);
+    }
+  }
+};
+template <typename Tp, typename Up, typename UnaryOperation>
+struct transform_task {
+  const Tp* first;
+  size_t n;
+  Up* result;
+  const UnaryOperation* op;
+  void operator()(unsigned i, unsigned threads) const {
+    size_t begin, end;
+    parallel_chunk(result, n, i, threads, &begin, &end);
+    for (size_t k = begin; k < end; ++k) result[k] = (*op)(first[k]);
+  }
+};
+template <typename Tp, typename BinaryOperation>
+struct reduce_task {
+  const Tp* first;
+  size_t n;
+  const BinaryOperation* op;
+  Tp* partials;
+  unsigned char* nonempty;
+  void operator()(unsigned i, unsigned threads) const {
+    size_t begin, end;
+    parallel_chunk(first, n, i, threads, &begin, &end);
+    nonempty[i] = begin != end;
+    if (begin == end) return;
+    Tp sum = first[begin];
+    for (size_t k = begin + 1; k < end; ++k) sum = (*op)(sum, first[k]);
+    partials[i] = sum;
+  }
+};
+
+template <typename Tp>
+void parallel_fill(const parallel_policy& policy, Tp* first, Tp* last,
+                   const Tp& value) {
+  if (policy.serial(last - first, sizeof(Tp))) {
+    mystl::fill(first, last, value);
+    return;
+  }
+  const Tp tmp = value;  // value may live inside [first, last)
+  fill_task<Tp> task = {first, size_t(last - first), &tmp, false};
+  policy.pool().run(task);
+}
+template <typename Tp>
+Tp* parallel_uninitialized_fill_n(const parallel_policy& policy, Tp* first,
+                                  size_t n, const Tp& value) {
+  if (policy.serial(n, sizeof(Tp))) {
+    return mystl::uninitialized_fill_n(first, n, value);
+  }
+  fill_task<Tp> task = {first, n, &value, true};
+  policy.pool().run(task);
+  return first + n;
+}
+// The ranges must not overlap.
+template <typename Tp>
+Tp* parallel_copy(const parallel_policy& policy, const Tp* first,
+                  const Tp* last, Tp* result) {
+  if (policy.serial(last - first, sizeof(Tp))) {
+    return mystl::copy(first, last, result);
+  }
+  copy_task<Tp> task = {first, size_t(last - first), result, false};
+  policy.pool().run(task);
+  return result + (last - first);
+}
+template <typename Tp>
+Tp* parallel_uninitialized_copy(const parallel_policy& policy,
+                                const Tp* first, const Tp* last, Tp* result) {
+  if (policy.serial(last - first, sizeof(Tp))) {
+    return mystl::uninitialized_copy(first, last, result);
+  }
+  copy_task<Tp> task = {first, size_t(last - first), result, true};
+  policy.pool().run(task);
+  return result + (last - first);
+}
+// result may equal first.
+template <typename Tp, typename Up, typename UnaryOperation>
+Up* parallel_transform(const parallel_policy& policy, const Tp* first,
+                       const Tp* last, Up* result, UnaryOperation op) {
+  transform_task<Tp, Up, UnaryOperation> task =
+    {first, size_t(last - first), result, &op};
+  if (policy.serial(last - first, sizeof(Up))) {
+    task(0, 1);
+  } else {
+    policy.pool().run(task);
+  }
+  return result + (last - first);
+}
+/* op must be associative; chunks are reduced in parallel and their sums
+ * combined with init from left to right.
+ */
+template <typename Tp, typename BinaryOperation>
+Tp parallel_reduce(const parallel_policy& policy, const Tp* first,
+                   const Tp* last, Tp init, BinaryOperation op) {
+  if (policy.serial(last - first, sizeof(Tp))) {
+    for (; first != last; ++first) init = op(init, *first);
+    return init;
+  }
+  thread_pool& pool = policy.pool();
+  vector<Tp> partials(pool.concurrency(), init);
+  vector<unsigned char> nonempty(pool.concurrency(), 0);
+  reduce_task<Tp, BinaryOperation> task = {first, size_t(last - first), &op,
+    partials.data(), nonempty.data()};
+  pool.run(task);
+  for (size_t i = 0; i < partials.size(); ++i) {
+    if (nonempty[i]) init = op(init, partials[i]);
+  }
+  return init;
+}
+
+/* parallel_vector
+ * A vector whose construction, copies and fill assignments run through
+ * the parallel algorithms above. Being a vector, it can be passed on as
+ * one, or moved into a plain vector once built.
+ */
+template <typename Tp, typename Allocator = new_allocator<Tp>,
+          typename GrowthPolicy = double_growth>
+class parallel_vector : public vector<Tp, Allocator, GrowthPolicy> {
+  typedef vector<Tp, Allocator, GrowthPolicy> base;
+public:
+  typedef typename base::size_type size_type;
+
+  explicit parallel_vector(const parallel_policy& policy = parallel_policy())
+    : policy_(policy) {}
+  // Value-initialized elements.
+  explicit parallel_vector(size_type n,
+                           const parallel_policy& policy = parallel_policy())
+    : policy_(policy) { assign(n, Tp()); }
+  parallel_vector(size_type n, const Tp& value,
+                  const parallel_policy& policy = parallel_policy())
+    : policy_(policy) { assign(n, value); }
+  explicit parallel_vector(const base& other,
+                           const parallel_policy& policy = parallel_policy())
+    : base(other.get_allocator()), policy_(policy) { assign(other); }
+  parallel_vector(const parallel_vector& other)
+    : base(other.get_allocator()), policy_(other.policy_) { assign(other); }
+  parallel_vector(parallel_vector&& other)
+    : base(mystl::move(other)), policy_(other.policy_) {}
+
+  parallel_vector& operator=(const parallel_vector& other) {
+    if (&other != this) assign(other);
+    return *this;
+  }
+  parallel_vector& operator=(parallel_vector&& other) {
+    base::operator=(mystl::move(other));
+    return *this;
+  }
+
+  void assign(size_type n, const Tp& value) {
+    const Tp tmp = value;  // value may refer into *this
+    prepare(n);
+    this->finish_ =
+      mystl::parallel_uninitialized_fill_n(policy_, this->start_, n, tmp);
+  }
+  void assign(const base& other) {
+    if (&other == this) return;
+    prepare(other.size());
+    this->finish_ = mystl::parallel_uninitialized_copy(
+      policy_, other.data(), other.data() + other.size(), this->start_);
+  }
+  // Ranges go to vector::assign(); assign(4, 9) still fills in parallel.
+  template <typename InputIterator>
+  void assign(InputIterator first, InputIterator last) {
+    assign_aux(first, last, typename is_integral<InputIterator>::type());
+  }
+
+  const parallel_policy& policy() const { return policy_; }
+
+private:
+  template <typename Integral>
+  void assign_aux(Integral n, Integral value, true_type) {
+    assign(size_type(n), Tp(value));
+  }
+  template <typename InputIterator>
+  void assign_aux(InputIterator first, InputIterator last, false_type) {
+    base::assign(first, last);
+  }
+  // Destroys the elements and makes room for n, without copying.
+  void prepare(size_type n) {
+    this->destroy(this->start_, this->finish_);
+    this->finish_ = this->start_;
+    if (n > this->capacity()) {
+      this->deallocate();
+      this->start_ = this->finish_ = this->end_of_storage_ = 0;
+      this->start_ = this->finish_ = this->allocate(n);
+      this->end_of_storage_ = this->start_ + n;
+    }
+  }
+
+  parallel_policy policy_;
+};
+
+}  // namespace mystl
+
+#endif  // MYSTL_PARALLEL_H
@@ -0,0 +1,577 @@
+/*
+ * Copyright 2016 Waizung Taam
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ==== Ring vector ====
+ *
+ * ring_vector<Tp> keeps its elements in one buffer used as a circular
+ * queue: a head index and a size mark the occupied part, which may wrap
+ * around the end of the buffer. push_front(), pop_front(), push_back()
+ * and pop_back() all take constant time, so a sliding window is kept
+ * without the O(n) erase(begin()) a vector needs on every step:
+ *
+ *   mystl::ring_vector<Sample> window;
+ *   window.push_back(sample);
+ *   if (window.size() > width) window.pop_front();
+ *
+ * The capacity is a power of two, so element i is at
+ * buffer[(head + i) & (capacity - 1)] and random access costs an add and
+ * a mask. When the buffer is full it doubles, and the elements are moved
+ * to the start of the new one.
+ *
+ * The elements are contiguous only while they do not wrap. linearize()
+ * makes them contiguous, moving them into a new buffer if they wrap, and
+ * returns a span over them that stays valid until the next push or
+ * reserve().
+ *
+ * Modifiers are limited to the ends. Allocators are not propagated on
+ * assignment; swap() requires equal allocators.
+ */
+
+/* - ring_iterator<Tp, Ref, Ptr>
+ * - ring_vector<Tp, Allocator>
+ *   - public
+ *     - ctors, op=, dtor
+ *     - get_allocator()
+ *     - accessors
+ *     - iterators
+ *     - capacity
+ *     - modifiers
+ *     - linearize(), is_linear()
+ *   - private
+ *     - initialize_aux(), fill_initialize(), copy_from()
+ *     - slot(), grow_and_emplace(), relocate_to(), reallocate()
+ *     - destroy_all(), release(), steal()
+ *     - range_check()
+ *     - data members
+ * - is_trivially_relocatable<ring_vector>
+ * - comparisons of ring_vectors
+ */
+#ifndef MYSTL_RING_VECTOR_H
+#define MYSTL_RING_VECTOR_H
+
+#include "span.h"
+
+namespace mystl {
+
+/* ring_iterator
+ * Holds the position as an offset from the start of the buffer that is
+ * not yet wrapped, head + i, so that iterators compare and subtract as
+ * plain indices; dereferencing applies the mask.
+ */
+template <typename Tp, typename Ref, typename Ptr>
+class ring_iterator {
+public:
+  typedef random_access_iterator_tag iterator_category;
+  typedef Tp value_type;
+  typedef ptrdiff_t difference_type;
+  typedef Ptr pointer;
+  typedef Ref reference;
+
+  ring_iterator() : buffer_(0), mask_(0), pos_(0) {}
+  ring_iterator(Tp* buffer, size_t mask, size_t pos) :
+    buffer_(buffer), mask_(mask), pos_(pos) {}
+  // iterator -> const_iterator
+  template <typename Ref1, typename Ptr1>
+  ring_iterator(const ring_iterator<Tp, Ref1, Ptr1>& other) :
+    buffer_(other.buffer()), mask_(other.mask()), pos_(other.pos()) {}
+
+  Tp* buffer() const { return buffer_; }
+  size_t mask() const { return mask_; }
+  size_t pos() const { return pos_; }
+
+  reference operator*() const { return buffer_[pos_ & mask_]; }
+  pointer operator->() const { return buffer_ + (pos_ & mask_); }
+  reference operator[](difference_type n) const {
+    return buffer_[(pos_ + n) & mask_];
+  }
+
+  ring_iterator& operator++() {
+    ++pos_;
+    return *this;
+  }
+  ring_iterator operator++(int) {
+    ring_iterator tmp = *this;
+    ++pos_;
+    return tmp;
+  }
+  ring_iterator& operator--() {
+    --pos_;
+    return *this;
+  }
+  ring_iterator operator--(int) {
+    ring_iterator tmp = *this;
+    --pos_;
+    return tmp;
+  }
+  ring_iterator& operator+=(difference_type n) {
+    pos_ += n;
+    return *this;
+  }
+  ring_iterator& operator-=(difference_type n) {
+    pos_ -= n;
+    return *this;
+  }
+  ring_iterator operator+(difference_type n) const {
+    return ring_iterator(buffer_, mask_, pos_ + n);
+  }
+  ring_iterator operator-(difference_type n) const {
+    return ring_iterator(buffer_, mask_, pos_ - n);
+  }
+  difference_type operator-(const ring_iterator& other) const {
+    return difference_type(pos_ - other.pos_);
+  }
+
+  bool operator==(const ring_iterator& other) const {
+    return pos_ == other.pos_;
+  }
+  bool operator!=(const ring_iterator& other) const {
+    return pos_ != other.pos_;
+  }
+  bool operator<(const ring_iterator& other) const {
+    return pos_ < other.pos_;
+  }
+  bool operator>(const ring_iterator& other) const {
+    return pos_ > other.pos_;
+  }
+  bool operator<=(const ring_iterator& other) const {
+    return pos_ <= other.pos_;
+  }
+  bool operator>=(const ring_iterator& other) const {
+    return pos_ >= other.pos_;
+  }
+
+private:
+  Tp* buffer_;
+  size_t mask_;
+  size_t pos_;
+};
+
+template <typename Tp, typename Allocator = new_allocator<Tp>>
+class ring_vector {
+public:
+  typedef Tp value_type;
+  typedef Allocator allocator_type;
+  typedef size_t size_type;
+  typedef ptrdiff_t difference_type;
+  typedef Tp& reference;
+  typedef const Tp& const_reference;
+  typedef Tp* pointer;
+  typedef const Tp* const_pointer;
+  typedef ring_iterator<Tp, Tp&, Tp*> iterator;
+  typedef ring_iterator<Tp, const Tp&, const Tp*> const_iterator;
+  typedef mystl::reverse_iterator<iterator> reverse_iterator;
+  typedef mystl::reverse_iterator<const_iterator> const_reverse_iterator;
+
+  /* ctors, op=, dtor
+   * An empty ring_vector has no buffer, so default construction and
+   * moves never allocate.
+   */
+  ring_vector() : allocator_(Allocator()) { reset(); }
+  explicit ring_vector(const Allocator& alloc) : allocator_(alloc) {
+    reset();
+  }
+  explicit ring_vector(size_type n, const Allocator& alloc = Allocator()) :
+    allocator_(alloc) {
+    reset();
+    fill_initialize(n, Tp());
+  }
+  ring_vector(size_type n, const Tp& value,
+              const Allocator& alloc = Allocator()) :
+    allocator_(alloc) {
+    reset();
+    fill_initialize(n, value);
+  }
+  template <typename InputIterator>
+  ring_vector(InputIterator first, InputIterator last,
+              const Allocator& alloc = Allocator()) :
+    allocator_(alloc) {
+    reset();
+    initialize_aux(first, last, typename is_integral<InputIterator>::type());
+  }
+  ring_vector(const ring_vector& other) : allocator_(other.allocator_) {
+    reset();
+    try {
+      copy_from(other);
+    } catch (...) {
+      destroy_all();
+      release();
+      throw;
+    }
+  }
+  ring_vector(ring_vector&& other) noexcept :
+    allocator_(mystl::move(other.allocator_)) {
+    reset();
+    steal(other);
+  }
+  ~ring_vector() {
+    destroy_all();
+    release();
+  }
+
+  ring_vector& operator=(const ring_vector& other) {
+    if (this != &other) {
+      clear();
+      copy_from(other);
+    }
+    return *this;
+  }
+  ring_vector& operator=(ring_vector&& other) {
+    if (this != &other) {
+      clear();
+      if (allocator_ == other.allocator_) {
+        release();
+        steal(other);
+      } else {
+        reserve(other.size_);
+        for (iterator it = other.begin(); it != other.end(); ++it) {
+          push_back(mystl::move(*it));
+        }
+        other.clear();
+      }
+    }
+    return *this;
+  }
+
+  allocator_type get_allocator() const { return allocator_; }
+
+  /* accessors */
+  reference operator[](size_type pos) { return buffer_[slot(pos)]; }
+  const_reference operator[](size_type pos) const {
+    return buffer_[slot(pos)];
+  }
+  reference at(size_type pos) {
+    range_check(pos);
+    return buffer_[slot(pos)];
+  }
+  const_reference at(size_type pos) const {
+    range_check(pos);
+    return buffer_[slot(pos)];
+  }
+  reference front() { return buffer_[head_]; }
+  const_reference front() const { return buffer_[head_]; }
+  reference back() { return buffer_[slot(size_ - 1)]; }
+  const_reference back() const { return buffer_[slot(size_ - 1)]; }
+
+  /* iterators */
+  iterator begin() { return iterator(buffer_, mask_, head_); }
+  const_iterator begin() const {
+    return const_iterator(buffer_, mask_, head_);
+  }
+  const_iterator cbegin() const { return begin(); }
+  iterator end() { return iterator(buffer_, mask_, head_ + size_); }
+  const_iterator end() const {
+    return const_iterator(buffer_, mask_, head_ + size_);
+  }
+  const_iterator cend() const { return end(); }
+  reverse_iterator rbegin() { return reverse_iterator(end()); }
+  const_reverse_iterator rbegin() const {
+    return const_reverse_iterator(end());
+  }
+  const_reverse_iterator crbegin() const { return rbegin(); }
+  reverse_iterator rend() { return reverse_iterator(begin()); }
+  const_reverse_iterator rend() const {
+    return const_reverse_iterator(begin());
+  }
+  const_reverse_iterator crend() const { return rend(); }
+
+  /* capacity */
+  size_type size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  // The largest power of two the allocator can provide.
+  size_type max_size() const {
+    size_type n = allocator_.max_size();
+    return n == 0 ? 0 : size_type(1) << (63 - __builtin_clzl(n));
+  }
+  size_type capacity() const { return buffer_ == 0 ? 0 : mask_ + 1; }
+  // Rounds n up to a power of two.
+  void reserve(size_type n) {
+    if (n <= capacity()) return;
+    if (n > max_size()) throw "Out-of-memory";
+    reallocate(round_up(n));
+  }
+  // Shrinks the buffer to the smallest power of two that holds the size.
+  void shrink_to_fit() {
+    if (size_ == 0) {
+      release();
+    } else if (round_up(size_) < capacity()) {
+      reallocate(round_up(size_));
+    }
+  }
+
+  /* modifiers */
+  void push_back(const Tp& value) { emplace_back(value); }
+  void push_back(Tp&& value) { emplace_back(mystl::move(value)); }
+  template <typename... Args>
+  void emplace_back(Args&&... args) {
+    if (size_ == capacity()) {
+      grow_and_emplace(false, mystl::forward<Args>(args)...);
+      return;
+    }
+    allocator_.construct(buffer_ + slot(size_),
+                         mystl::forward<Args>(args)...);
+    ++size_;
+  }
+  void push_front(const Tp& value) { emplace_front(value); }
+  void push_front(Tp&& value) { emplace_front(mystl::move(value)); }
+  template <typename... Args>
+  void emplace_front(Args&&... args) {
+    if (size_ == capacity()) {
+      grow_and_emplace(true, mystl::forward<Args>(args)...);
+      return;
+    }
+    size_type new_head = (head_ - 1) & mask_;
+    allocator_.construct(buffer_ + new_head, mystl::forward<Args>(args)...);
+    head_ = new_head;
+    ++size_;
+  }
+  void pop_back() {
+    --size_;
+    allocator_.destroy(buffer_ + slot(size_));
+  }
+  void pop_front() {
+    allocator_.destroy(buffer_ + head_);
+    head_ = (head_ + 1) & mask_;
+    --size_;
+  }
+  // Keeps the buffer, like vector::clear() keeps the capacity.
+  void clear() { destroy_all(); }
+  void swap(ring_vector& other) {
+    mystl::swap(buffer_, other.buffer_);
+    mystl::swap(mask_, other.mask_);
+    mystl::swap(head_, other.head_);
+    mystl::swap(size_, other.size_);
+  }
+
+  /* linearize(), is_linear()
+   * linearize() moves wrapped elements into a new buffer of the same
+   * capacity, in order from its start; elements that do not wrap stay
+   * where they are. Either way it returns a span over all of them.
+   */
+  span<Tp> linearize() {
+    if (!is_linear()) reallocate(capacity());
+    return span<Tp>(buffer_ + head_, size_);
+  }
+  bool is_linear() const { return head_ + size_ <= capacity(); }
+
+private:
+  void reset() {
+    buffer_ = 0;
+    mask_ = head_ = size_ = 0;
+  }
+  template <typename Integral>
+  void initialize_aux(Integral n, Integral value, true_type) {
+    fill_initialize(size_type(n), Tp(value));
+  }
+  void fill_initialize(size_type n, const Tp& value) {
+    try {
+      reserve(n);
+      while (size_ < n) push_back(value);
+    } catch (...) {
+      destroy_all();
+      release();
+      throw;
+    }
+  }
+  template <typename InputIterator>
+  void initialize_aux(InputIterator first, InputIterator last, false_type) {
+    try {
+      for (; first != last; ++first) push_back(*first);
+    } catch (...) {
+      destroy_all();
+      release();
+      throw;
+    }
+  }
+  // Appends the elements of other to an empty ring_vector.
+  void copy_from(const ring_vector& other) {
+    reserve(other.size_);
+    for (const_iterator it = other.begin(); it != other.end(); ++it) {
+      push_back(*it);
+    }
+  }
+
+  static size_type round_up(size_type n) {
+    return n <= 1 ? 1 : size_type(1) << (64 - __builtin_clzl(n - 1));
+  }
+  // The index in buffer_ of element pos.
+  size_type slot(size_type pos) const { return (head_ + pos) & mask_; }
+
+  /* Builds the new element in a buffer of twice the capacity before
+   * moving the others there, so that args may refer to one of them. A
+   * front element goes in the last slot and the others from slot 0, so
+   * the new buffer starts out wrapped.
+   */
+  template <typename... Args>
+  void grow_and_emplace(bool front, Args&&... args) {
+    size_type n = capacity() == 0 ? initial_capacity : 2 * capacity();
+    if (n > max_size() || n < capacity()) throw "Out-of-memory";
+    Tp* new_buffer = allocator_.allocate(n);
+    size_type pos = front ? n - 1 : size_;
+    try {
+      allocator_.construct(new_buffer + pos, mystl::forward<Args>(args)...);
+    } catch (...) {
+      allocator_.deallocate(new_buffer, n);
+      throw;
+    }
+    try {
+      relocate_to(new_buffer);
+    } catch (...) {
+      allocator_.destroy(new_buffer + pos);
+      allocator_.deallocate(new_buffer, n);
+      throw;
+    }
+    release();
+    buffer_ = new_buffer;
+    mask_ = n - 1;
+    head_ = front ? n - 1 : 0;
+    size_ = size_ + 1;
+  }
+  /* Moves the elements, in order, to raw storage at result and destroys
+   * the originals; copies them instead if Tp's move constructor may
+   * throw, so that the ring is unchanged if a copy throws. Trivially
+   * relocatable elements are copied as bytes, at most two runs of them.
+   */
+  void relocate_to(Tp* result) {
+    if (is_trivially_relocatable<Tp>::value) {
+      size_type first_run = capacity() - head_ < size_ ?
+                            capacity() - head_ : size_;
+      if (first_run != 0) {
+        __builtin_memcpy(static_cast<void*>(result),
+                         static_cast<const void*>(buffer_ + head_),
+                         first_run * sizeof(Tp));
+      }
+      if (size_ != first_run) {
+        __builtin_memcpy(static_cast<void*>(result + first_run),
+                         static_cast<const void*>(buffer_),
+                         (size_ - first_run) * sizeof(Tp));
+      }
+      return;
+    }
+    size_type done = 0;
+    try {
+      for (; done < size_; ++done) {
+        allocator_.construct(result + done,
+                             mystl::move_if_noexcept(buffer_[slot(done)]));
+      }
+    } catch (...) {
+      for (size_type i = 0; i < done; ++i) allocator_.destroy(result + i);
+      throw;
+    }
+    for (size_type i = 0; i < size_; ++i) {
+      allocator_.destroy(buffer_ + slot(i));
+    }
+  }
+  // Moves the elements to the start of a new buffer of n slots.
+  void reallocate(size_type n) {
+    Tp* new_buffer = allocator_.allocate(n);
+    try {
+      relocate_to(new_buffer);
+    } catch (...) {
+      allocator_.deallocate(new_buffer, n);
+      throw;
+    }
+    release();
+    buffer_ = new_buffer;
+    mask_ = n - 1;
+    head_ = 0;
+  }
+
+  void destroy_all() {
+    if (!is_trivially_destructible<Tp>::value) {
+      for (size_type i = 0; i < size_; ++i) {
+        allocator_.destroy(buffer_ + slot(i));
+      }
+    }
+    head_ = size_ = 0;
+  }
+  // Frees the buffer; its elements must have been destroyed or moved.
+  void release() {
+    if (buffer_ != 0) allocator_.deallocate(buffer_, mask_ + 1);
+    buffer_ = 0;
+    mask_ = head_ = 0;
+  }
+  void steal(ring_vector& other) {
+    buffer_ = other.buffer_;
+    mask_ = other.mask_;
+    head_ = other.head_;
+    size_ = other.size_;
+    other.reset();
+  }
+
+  void range_check(size_type n) const {
+    if (n >= size_) throw "Out-of-range";
+  }
+
+  /* data members
+   * mask_ is capacity() - 1, and head_ is always below capacity(); both
+   * are 0 while there is no buffer.
+   */
+  static const size_type initial_capacity = 8;
+
+  Allocator allocator_;
+  Tp* buffer_;
+  size_type mask_;
+  size_type head_;
+  size_type size_;
+};
+
+template <typename Tp, typename Allocator>
+struct is_trivially_relocatable<ring_vector<Tp, Allocator>> :
+  is_trivially_relocatable<Allocator> {};
+
+template <typename Tp, typename Allocator>
+bool operator==(const ring_vector<Tp, Allocator>& x,
+                const ring_vector<Tp, Allocator>& y) {
+  if (x.size() != y.size()) return false;
+  for (size_t i = 0; i < x.size(); ++i) {
+    if (!(x[i] == y[i])) return false;
+  }
+  return true;
+}
+template <typename Tp, typename Allocator>
+bool operator<(const ring_vector<Tp, Allocator>& x,
+               const ring_vector<Tp, Allocator>& y) {
+  size_t n = x.size() < y.size() ? x.size() : y.size();
+  for (size_t i = 0; i < n; ++i) {
+    if (x[i] < y[i]) return true;
+    if (y[i] < x[i]) return false;
+  }
+  return x.size() < y.size();
+}
+template <typename Tp, typename Allocator>
+bool operator!=(const ring_vector<Tp, Allocator>& x,
+                const ring_vector<Tp, Allocator>& y) {
+  return !(x == y);
+}
+template <typename Tp, typename Allocator>
+bool operator>(const ring_vector<Tp, Allocator>& x,
+               const ring_vector<Tp, Allocator>& y) {
+  return y < x;
+}
+template <typename Tp, typename Allocator>
+bool operator<=(const ring_vector<Tp, Allocator>& x,
+                const ring_vector<Tp, Allocator>& y) {
+  return !(y < x);
+}
+template <typename Tp, typename Allocator>
+bool operator>=(const ring_vector<Tp, Allocator>& x,
+                const ring_vector<Tp, Allocator>& y) {
+  return !(x < y);
+}
+
+}  // namespace mystl
+
+#endif  // MYSTL_RING_VECTOR_H
@@ -0,0 +1,190 @@
+/*
+ * Copyright 2016 Waizung Taam
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ==== Segment tables ====
+ *
+ * Segmented containers keep their elements in a table of separately
+ * allocated segments that never move once allocated, so growing the
+ * container leaves every existing element, and every reference to it, in
+ * place. With a first segment of 2^FirstLog2 elements, segment k holds
+ *
+ *   2^(FirstLog2 + k) elements, starting at index 2^FirstLog2 * (2^k - 1),
+ *
+ * so each segment is one larger than all earlier ones together, capacity
+ * at most doubles per segment and the segment of an index is found with
+ * one bit scan, without a loop or a lookup.
+ */
+
+/* - segment_layout<FirstLog2>
+ * - segment_iterator<Tp, Ref, Ptr, FirstLog2>
+ */
+#ifndef MYSTL_SEGMENT_TABLE_H
+#define MYSTL_SEGMENT_TABLE_H
+
+#include "vector.h"
+
+namespace mystl {
+
+template <size_t FirstLog2>
+struct segment_layout {
+  static const size_t first_size = size_t(1) << FirstLog2;
+  static const size_t max_segments = 64 - FirstLog2;
+
+  static size_t segment_of(size_t index) {
+    return 63 - __builtin_clzl((index >> FirstLog2) + 1);
+  }
+  static size_t segment_begin(size_t k) {
+    return ((size_t(1) << k) - 1) << FirstLog2;
+  }
+  static size_t segment_size(size_t k) {
+    return first_size << k;
+  }
+  // Number of segments needed to hold n elements.
+  static size_t segments_for(size_t n) {
+    return n == 0 ? 0 : segment_of(n - 1) + 1;
+  }
+  // Capacity of the first k segments.
+  static size_t capacity_of(size_t k) {
+    return segment_begin(k);
+  }
+};
+
+/* segment_iterator
+ * Random-access iterator over a segment table. It caches the position in
+ * the current segment so that stepping through a segment costs the same
+ * as stepping a pointer; only crossing into the next segment goes back to
+ * the table. Segments past the end may be unallocated, so an iterator
+ * there holds a null position until it is moved back into range.
+ */
+template <typename Tp, typename Ref, typename Ptr, size_t FirstLog2>
+class segment_iterator {
+public:
+  typedef random_access_iterator_tag iterator_category;
+  typedef Tp value_type;
+  typedef ptrdiff_t difference_type;
+  typedef Ptr pointer;
+  typedef Ref reference;
+  typedef segment_layout<FirstLog2> layout;
+
+  segment_iterator() :
+    table_(0), index_(0), cur_(0), first_(0), last_(0) {}
+  segment_iterator(Tp* const* table, size_t index) :
+    table_(table), index_(index) { locate(); }
+  // iterator -> const_iterator
+  template <typename Ref1, typename Ptr1>
+  segment_iterator(
+    const segment_iterator<Tp, Ref1, Ptr1, FirstLog2>& other) :
+    table_(other.table()), index_(other.index()) { locate(); }
+
+  Tp* const* table() const { return table_; }
+  size_t index() const { return index_; }
+
+  reference operator*() const { return *cur_; }
+  pointer operator->() const { return cur_; }
+  reference operator[](difference_type n) const { return *(*this + n); }
+
+  segment_iterator& operator++() {
+    ++index_;
+    if (cur_ == 0 || ++cur_ == last_) locate();
+    return *this;
+  }
+  segment_iterator operator++(int) {
+    segment_iterator tmp = *this;
+    ++*this;
+    return tmp;
+  }
+  segment_iterator& operator--() {
+    --index_;
+    if (cur_ == first_) {
+      locate();
+    } else {
+      --cur_;
+    }
+    return *this;
+  }
+  segment_iterator operator--(int) {
+    segment_iterator tmp = *this;
+    --*this;
+    return tmp;
+  }
+  segment_iterator& operator+=(difference_type n) {
+    index_ += n;
+    locate();
+    return *this;
+  }
+  segment_iterator& operator-=(difference_type n) { return *this += -n; }
+  segment_iterator operator+(difference_type n) const {
+    segment_iterator tmp = *this;
+    return tmp += n;
+  }
+  segment_iterator operator-(difference_type n) const {
+    segment_iterator tmp = *this;
+    return tmp -= n;
+  }
+  difference_type operator-(const segment_iterator& other) const {
+    return difference_type(index_ - other.index_);
+  }
+
+  bool operator==(const segment_iterator& other) const {
+    return index_ == other.index_;
+  }
+  bool operator!=(const segment_iterator& other) const {
+    return index_ != other.index_;
+  }
+  bool operator<(const segment_iterator& other) const {
+    return index_ < other.index_;
+  }
+  bool operator>(const segment_iterator& other) const {
+    return index_ > other.index_;
+  }
+  bool operator<=(const segment_iterator& other) const {
+    return index_ <= other.index_;
+  }
+  bool operator>=(const segment_iterator& other) const {
+    return index_ >= other.index_;
+  }
+
+  // End of the current segment, for loops that work a segment at a time.
+  Ptr segment_end() const { return last_; }
+
+private:
+  void locate() {
+    size_t k = layout::segment_of(index_);
+    Tp* segment = table_ != 0 && k < layout::max_segments ? table_[k] : 0;
+    if (segment == 0) {
+      cur_ = first_ = last_ = 0;
+    } else {
+      first_ = segment;
+      cur_ = segment + (index_ - layout::segment_begin(k));
+      last_ = segment + layout::segment_size(k);
+    }
+  }
+
+  Tp* const* table_;
+  size_t index_;
+  Tp* cur_;
+  Tp* first_;
+  Tp* last_;
+};
+template <typename Tp, typename Ref, typename Ptr, size_t FirstLog2>
+inline segment_iterator<Tp, Ref, Ptr, FirstLog2> operator+(
+    ptrdiff_t n, const segment_iterator<Tp, Ref, Ptr, FirstLog2>& it) {
+  return it + n;
+}
+
+}  // namespace mystl
+
+#endif  // MYSTL_SEGMENT_TABLE_H
@@ -0,0 +1,436 @@
+/*
+ * Copyright 2016 Waizung Taam
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ==== Segmented vector ====
+ *
+ * segmented_vector<Tp> is a vector that grows by adding segments instead
+ * of reallocating: push_back() never copies or moves existing elements,
+ * so it has no growth spike, and pointers, references and iterators to
+ * elements stay valid until those elements are erased.
+ *
+ * Segments double in size (see segment_table.h), so the table of segments
+ * has a fixed size, random access is one bit scan away and at most half
+ * of the capacity is unused. The price is that storage is contiguous only
+ * within a segment: data() does not exist and iteration crosses a segment
+ * boundary log2(n) times.
+ *
+ * Modifiers are limited to the ends. Allocators are not propagated on
+ * assignment; swap() requires equal allocators.
+ */
+
+/* - segmented_vector<Tp, Allocator, FirstLog2>
+ *   - public
+ *     - ctors, op=, dtor
+ *     - get_allocator()
+ *     - accessors
+ *     - iterators
+ *     - capacity
+ *     - modifiers
+ *   - private
+ *     - initialize_aux(), fill_initialize(), copy_from()
+ *     - segment(), grow()
+ *     - destroy_from(), locate_finish(), release()
+ *     - steal()
+ *     - range_check()
+ *     - data members
+ * - comparisons of segmented_vectors
+ */
+#ifndef MYSTL_SEGMENTED_VECTOR_H
+#define MYSTL_SEGMENTED_VECTOR_H
+
+#include "segment_table.h"
+
+namespace mystl {
+
+template <typename Tp, typename Allocator = new_allocator<Tp>,
+          size_t FirstLog2 = 4>
+class segmented_vector {
+public:
+  typedef segment_layout<FirstLog2> layout;
+  typedef Tp value_type;
+  typedef Allocator allocator_type;
+  typedef size_t size_type;
+  typedef ptrdiff_t difference_type;
+  typedef Tp& reference;
+  typedef const Tp& const_reference;
+  typedef Tp* pointer;
+  typedef const Tp* const_pointer;
+  typedef segment_iterator<Tp, Tp&, Tp*, FirstLog2> iterator;
+  typedef segment_iterator<Tp, const Tp&, const Tp*, FirstLog2>
+          const_iterator;
+  typedef mystl::reverse_iterator<iterator> reverse_iterator;
+  typedef mystl::reverse_iterator<const_iterator> const_reverse_iterator;
+
+  segmented_vector() : allocator_(Allocator()) { reset(); }
+  explicit segmented_vector(const Allocator& alloc) : allocator_(alloc) {
+    reset();
+  }
+  explicit segmented_vector(size_type n,
+                            const Allocator& alloc = Allocator()) :
+    allocator_(alloc) {
+    reset();
+    fill_initialize(n, Tp());
+  }
+  segmented_vector(size_type n, const Tp& value,
+                   const Allocator& alloc = Allocator()) :
+    allocator_(alloc) {
+    reset();
+    fill_initialize(n, value);
+  }
+  template <typename InputIterator>
+  segmented_vector(InputIterator first, InputIterator last,
+                   const Allocator& alloc = Allocator()) :
+    allocator_(alloc) {
+    reset();
+    initialize_aux(first, last, typename is_integral<InputIterator>::type());
+  }
+  segmented_vector(const segmented_vector& other) :
+    allocator_(other.allocator_) {
+    reset();
+    copy_from(other);
+  }
+  segmented_vector(segmented_vector&& other) noexcept :
+    allocator_(mystl::move(other.allocator_)) {
+    reset();
+    steal(other);
+  }
+  ~segmented_vector() {
+    destroy_from(0);
+    release(0);
+  }
+
+  segmented_vector& operator=(const segmented_vector& other) {
+    if (this != &other) {
+      clear();
+      copy_from(other);
+    }
+    return *this;
+  }
+  segmented_vector& operator=(segmented_vector&& other) {
+    if (this != &other) {
+      clear();
+      if (allocator_ == other.allocator_) {
+        release(0);
+        steal(other);
+      } else {
+        for (iterator it = other.begin(); it != other.end(); ++it) {
+          push_back(mystl::move(*it));
+        }
+        other.clear();
+      }
+    }
+    return *this;
+  }
+
+  allocator_type get_allocator() const { return allocator_; }
+
+  /* accessors */
+  reference operator[](size_type pos) {
+    size_type k = layout::segment_of(pos);
+    return segments_[k][pos - layout::segment_begin(k)];
+  }
+  const_reference operator[](size_type pos) const {
+    size_type k = layout::segment_of(pos);
+    return segments_[k][pos - layout::segment_begin(k)];
+  }
+  reference at(size_type pos) {
+    range_check(pos);
+    return (*this)[pos];
+  }
+  const_reference at(size_type pos) const {
+    range_check(pos);
+    return (*this)[pos];
+  }
+  reference front() { return segments_[0][0]; }
+  const_reference front() const { return segments_[0][0]; }
+  reference back() { return (*this)[size_ - 1]; }
+  const_reference back() const { return (*this)[size_ - 1]; }
+
+  /* iterators */
+  iterator begin() { return iterator(segments_, 0); }
+  const_iterator begin() const { return const_iterator(segments_, 0); }
+  const_iterator cbegin() const { return begin(); }
+  iterator end() { return iterator(segments_, size_); }
+  const_iterator end() const { return const_iterator(segments_, size_); }
+  const_iterator cend() const { return end(); }
+  reverse_iterator rbegin() { return reverse_iterator(end()); }
+  const_reverse_iterator rbegin() const {
+    return const_reverse_iterator(end());
+  }
+  const_reverse_iterator crbegin() const { return rbegin(); }
+  reverse_iterator rend() { return reverse_iterator(begin()); }
+  const_reverse_iterator rend() const {
+    return const_reverse_iterator(begin());
+  }
+  const_reverse_iterator crend() const { return rend(); }
+
+  /* capacity */
+  size_type size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  size_type max_size() const {
+    return layout::capacity_of(layout::max_segments);
+  }
+  size_type capacity() const { return layout::capacity_of(segment_count_); }
+  // Allocates segments up to a capacity of at least n; nothing moves.
+  void reserve(size_type n) {
+    if (n > max_size()) throw "Out-of-memory";
+    while (capacity() < n) segment(segment_count_);
+  }
+  // Frees the segments past the one holding the last element.
+  void shrink_to_fit() { release(layout::segments_for(size_)); }
+
+  /* modifiers */
+  void push_back(const Tp& value) {
+    if (finish_ == segment_end_) grow();
+    allocator_.construct(finish_, value);
+    ++finish_;
+    ++size_;
+  }
+  void push_back(Tp&& value) {
+    if (finish_ == segment_end_) grow();
+    allocator_.construct(finish_, mystl::move(value));
+    ++finish_;
+    ++size_;
+  }
+  template <typename... Args>
+  void emplace_back(Args&&... args) {
+    if (finish_ == segment_end_) grow();
+    allocator_.construct(finish_, mystl::forward<Args>(args)...);
+    ++finish_;
+    ++size_;
+  }
+  void pop_back() {
+    allocator_.destroy(&(*this)[size_ - 1]);
+    --size_;
+    locate_finish();
+  }
+  // Keeps the segments, like vector::clear() keeps the capacity.
+  void clear() { destroy_from(0); }
+  void resize(size_type n) {
+    if (n < size_) {
+      destroy_from(n);
+    } else {
+      reserve(n);
+      while (size_ < n) emplace_back();
+    }
+  }
+  void resize(size_type n, const Tp& value) {
+    if (n < size_) {
+      destroy_from(n);
+    } else {
+      reserve(n);
+      while (size_ < n) push_back(value);
+    }
+  }
+  void swap(segmented_vector& other) {
+    for (size_type k = 0; k < layout::max_segments; ++k) {
+      mystl::swap(segments_[k], other.segments_[k]);
+    }
+    mystl::swap(segment_count_, other.segment_count_);
+    mystl::swap(size_, other.size_);
+    mystl::swap(finish_, other.finish_);
+    mystl::swap(segment_end_, other.segment_end_);
+  }
+
+private:
+  void reset() {
+    for (size_type k = 0; k < layout::max_segments; ++k) segments_[k] = 0;
+    segment_count_ = size_ = 0;
+    finish_ = segment_end_ = 0;
+  }
+  template <typename Integral>
+  void initialize_aux(Integral n, Integral value, true_type) {
+    fill_initialize(size_type(n), Tp(value));
+  }
+  void fill_initialize(size_type n, const Tp& value) {
+    try {
+      resize(n, value);
+    } catch (...) {
+      destroy_from(0);
+      release(0);
+      throw;
+    }
+  }
+  template <typename InputIterator>
+  void initialize_aux(InputIterator first, InputIterator last, false_type) {
+    try {
+      for (; first != last; ++first) push_back(*first);
+    } catch (...) {
+      destroy_from(0);
+      release(0);
+      throw;
+    }
+  }
+  // Both vectors share the layout, so segments are copied as whole ranges.
+  void copy_from(const segmented_vector& other) {
+    try {
+      reserve(other.size_);
+      for (size_type k = 0; size_ < other.size_; ++k) {
+        size_type m = other.size_ - size_ < layout::segment_size(k) ?
+                      other.size_ - size_ : layout::segment_size(k);
+        finish_ = mystl::uninitialized_copy(
+          const_pointer(other.segments_[k]),
+          const_pointer(other.segments_[k] + m), segments_[k]);
+        segment_end_ = segments_[k] + layout::segment_size(k);
+        size_ += m;
+      }
+    } catch (...) {
+      destroy_from(0);
+      release(0);
+      throw;
+    }
+  }
+
+  // Allocates segment k, which must follow the allocated ones.
+  void segment(size_type k) {
+    if (k >= layout::max_segments) throw "Out-of-memory";
+    segments_[k] = allocator_.allocate(layout::segment_size(k));
+    segment_count_ = k + 1;
+  }
+  // Moves finish_ to the start of the next segment.
+  void grow() {
+    size_type k = layout::segment_of(size_);
+    if (k == segment_count_) segment(k);
+    finish_ = segments_[k];
+    segment_end_ = finish_ + layout::segment_size(k);
+  }
+
+  void destroy_from(size_type n) {
+    destroy_from_aux(n, typename is_trivially_destructible<Tp>::type());
+    size_ = n;
+    locate_finish();
+  }
+  /* Points finish_ past the last element, within the segment holding it,
+   * or at the start of the first segment if there is none. A size on a
+   * segment boundary thus leaves finish_ == segment_end_, and the next
+   * push_back() moves on through grow().
+   */
+  void locate_finish() {
+    if (size_ == 0) {
+      finish_ = segment_end_ = 0;
+      if (segment_count_ != 0) {
+        finish_ = segments_[0];
+        segment_end_ = finish_ + layout::segment_size(0);
+      }
+    } else {
+      size_type k = layout::segment_of(size_ - 1);
+      finish_ = segments_[k] + (size_ - layout::segment_begin(k));
+      segment_end_ = segments_[k] + layout::segment_size(k);
+    }
+  }
+  void destroy_from_aux(size_type n, true_type) {}
+  void destroy_from_aux(size_type n, false_type) {
+    for (iterator it = begin() + n, last = end(); it != last; ++it) {
+      allocator_.destroy(&*it);
+    }
+  }
+  // Frees the segments from k on; they must hold no elements.
+  void release(size_type k) {
+    for (; segment_count_ > k; --segment_count_) {
+      size_type last = segment_count_ - 1;
+      allocator_.deallocate(segments_[last], layout::segment_size(last));
+      segments_[last] = 0;
+    }
+    locate_finish();
+  }
+  void steal(segmented_vector& other) {
+    for (size_type k = 0; k < layout::max_segments; ++k) {
+      segments_[k] = other.segments_[k];
+    }
+    segment_count_ = other.segment_count_;
+    size_ = other.size_;
+    finish_ = other.finish_;
+    segment_end_ = other.segment_end_;
+    other.reset();
+  }
+
+  void range_check(size_type n) const {
+    if (n >= size_) throw "Out-of-range";
+  }
+
+  /* data members
+   * finish_ and segment_end_ bound the free part of the segment that
+   * push_back() appends to, so that appending within a segment costs one
+   * comparison, as in vector.
+   */
+  Allocator allocator_;
+  Tp* segments_[layout::max_segments];
+  size_type segment_count_;
+  size_type size_;
+  Tp* finish_;
+  Tp* segment_end_;
+};
+
+/* Equal sizes mean equal segment boundaries, so both comparisons run over
+ * whole segments with equal_aux() and less_aux() of vector.h.
+ */
+template <typename Tp, typename Allocator, size_t FirstLog2>
+bool operator==(const segmented_vector<Tp, Allocator, FirstLog2>& x,
+                const segmented_vector<Tp, Allocator, FirstLog2>& y) {
+  typedef segment_layout<FirstLog2> layout;
+  if (x.size() != y.size()) return false;
+  for (size_t k = 0, done = 0; done < x.size(); ++k) {
+    size_t m = x.size() - done < layout::segment_size(k) ?
+               x.size() - done : layout::segment_size(k);
+    if (!mystl::equal_aux(&x[done], &y[done], m,
+                          typename is_integral<Tp>::type())) {
+      return false;
+    }
+    done += m;
+  }
+  return true;
+}
+template <typename Tp, typename Allocator, size_t FirstLog2>
+bool operator<(const segmented_vector<Tp, Allocator, FirstLog2>& x,
+               const segmented_vector<Tp, Allocator, FirstLog2>& y) {
+  typedef segment_layout<FirstLog2> layout;
+  size_t n = x.size() < y.size() ? x.size() : y.size();
+  for (size_t k = 0, done = 0; done < n; ++k) {
+    size_t m = n - done < layout::segment_size(k) ?
+               n - done : layout::segment_size(k);
+    if (!mystl::equal_aux(&x[done], &y[done], m,
+                          typename is_integral<Tp>::type())) {
+      return mystl::less_aux(&x[done], m, &y[done], m,
+                             typename is_integral<Tp>::type());
+    }
+    done += m;
+  }
+  return x.size() < y.size();
+}
+template <typename Tp, typename Allocator, size_t FirstLog2>
+bool operator!=(const segmented_vector<Tp, Allocator, FirstLog2>& x,
+                const segmented_vector<Tp, Allocator, FirstLog2>& y) {
+  return !(x == y);
+}
+template <typename Tp, typename Allocator, size_t FirstLog2>
+bool operator>(const segmented_vector<Tp, Allocator, FirstLog2>& x,
+               const segmented_vector<Tp, Allocator, FirstLog2>& y) {
+  return y < x;
+}
+template <typename Tp, typename Allocator, size_t FirstLog2>
+bool operator<=(const segmented_vector<Tp, Allocator, FirstLog2>& x,
+                const segmented_vector<Tp, Allocator, FirstLog2>& y) {
+  return !(y < x);
+}
+template <typename Tp, typename Allocator, size_t FirstLog2>
+bool operator>=(const segmented_vector<Tp, Allocator, FirstLog2>& x,
+                const segmented_vector<Tp, Allocator, FirstLog2>& y) {
+  return !(x < y);
+}
+
+}  // namespace mystl
+
+#endif  // MYSTL_SEGMENTED_VECTOR_H
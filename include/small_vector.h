@@ -0,0 +1,236 @@
+/*
+ * Copyright 2016 Waizung Taam
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ==== Small-buffer-optimized vector ====
+ *
+ * small_vector<Tp, N> keeps up to N elements inside the object and only
+ * goes to the heap once it grows beyond that. It is a vector whose
+ * allocator owns an inline buffer: the growth paths of vector are reused
+ * unchanged, the allocator hands out the inline buffer while it is free
+ * and forwards everything else to the underlying allocator.
+ *
+ * Since the inline buffer lives inside the object, moving and swapping
+ * small_vectors has to move the elements when they are stored inline.
+ *
+ * The growth policy is wrapped in small_buffer_growth, which never trims
+ * below N: a trimming policy then moves the elements back into the inline
+ * buffer once they fit, instead of into a heap buffer smaller than it.
+ */
+
+/* - small_buffer_allocator<Tp, N, Allocator>
+ * - small_buffer_growth<GrowthPolicy, N>
+ * - small_vector<Tp, N, Allocator, GrowthPolicy>
+ *   - ctors, op=, dtor
+ *   - shrink_to_fit(), shrink_to()
+ *   - swap()
+ *   - is_inline()
+ */
+#ifndef MYSTL_SMALL_VECTOR_H
+#define MYSTL_SMALL_VECTOR_H
+
+#include "vector.h"
+
+namespace mystl {
+
+template <typename Tp, size_t N, typename Allocator = new_allocator<Tp>>
+class small_buffer_allocator : public Allocator {
+public:
+  typedef typename Allocator::size_type size_type;
+  typedef typename Allocator::pointer pointer;
+
+  template <typename Tp1>
+  struct rebind {
+    typedef small_buffer_allocator<Tp1, N,
+      typename Allocator::template rebind<Tp1>::other> other;
+  };
+
+  small_buffer_allocator() : in_use_(false) {}
+  explicit small_buffer_allocator(const Allocator& alloc) :
+    Allocator(alloc), in_use_(false) {}
+  // The inline buffer belongs to one container: copies start out empty.
+  small_buffer_allocator(const small_buffer_allocator& other) :
+    Allocator(other), in_use_(false) {}
+  small_buffer_allocator& operator=(const small_buffer_allocator& other) {
+    Allocator::operator=(other);
+    return *this;
+  }
+
+  pointer allocate(size_type n, const void* hint = 0) {
+    if (n <= N && !in_use_) {
+      in_use_ = true;
+      return inline_data();
+    }
+    return Allocator::allocate(n, hint);
+  }
+  void deallocate(pointer p, size_type n) {
+    if (p == inline_data()) {
+      in_use_ = false;
+    } else {
+      Allocator::deallocate(p, n);
+    }
+  }
+
+  pointer inline_data() { return reinterpret_cast<pointer>(buffer_); }
+  // Hands the inline buffer out without going through allocate().
+  pointer acquire_inline() {
+    in_use_ = true;
+    return inline_data();
+  }
+
+private:
+  // Hide the resizing hooks of Allocator: the inline buffer cannot grow.
+  pointer reallocate(pointer p, size_type old_n, size_type new_n,
+                     size_type used);
+  bool expand_in_place(pointer p, size_type old_n, size_type new_n);
+
+  alignas(Tp) unsigned char buffer_[N * sizeof(Tp)];
+  bool in_use_;
+};
+// Only the allocator owning an inline buffer may release it.
+template <typename Tp, size_t N, typename Allocator>
+inline bool operator==(const small_buffer_allocator<Tp, N, Allocator>& x,
+                       const small_buffer_allocator<Tp, N, Allocator>& y) {
+  return &x == &y;
+}
+template <typename Tp, size_t N, typename Allocator>
+inline bool operator!=(const small_buffer_allocator<Tp, N, Allocator>& x,
+                       const small_buffer_allocator<Tp, N, Allocator>& y) {
+  return !(x == y);
+}
+
+// Trims no further than the inline capacity. Once the heap buffer is
+// released, allocate(N) hands out the inline buffer again.
+template <typename GrowthPolicy, size_t N>
+struct small_buffer_growth : GrowthPolicy {
+  static size_t trim_capacity(size_t size, size_t capacity) {
+    size_t n = GrowthPolicy::trim_capacity(size, capacity);
+    return n < N ? N : n;
+  }
+};
+
+template <typename Tp, size_t N, typename Allocator = new_allocator<Tp>,
+          typename GrowthPolicy = double_growth>
+class small_vector :
+  public vector<Tp, small_buffer_allocator<Tp, N, Allocator>,
+                small_buffer_growth<GrowthPolicy, N>> {
+  typedef vector<Tp, small_buffer_allocator<Tp, N, Allocator>,
+                 small_buffer_growth<GrowthPolicy, N>> base;
+public:
+  typedef typename base::size_type size_type;
+  typedef typename base::iterator iterator;
+  typedef typename base::const_iterator const_iterator;
+  static const size_type inline_capacity = N;
+
+  small_vector() { init_inline(); }
+  explicit small_vector(const Allocator& alloc) :
+    base(small_buffer_allocator<Tp, N, Allocator>(alloc)) { init_inline(); }
+  explicit small_vector(size_type n) {
+    init_inline();
+    this->resize(n);
+  }
+  small_vector(size_type n, const Tp& value) {
+    init_inline();
+    this->assign(n, value);
+  }
+  template <typename InputIterator>
+  small_vector(InputIterator first, InputIterator last) {
+    init_inline();
+    this->insert(this->end(), first, last);
+  }
+  small_vector(const small_vector& other) :
+    base(small_buffer_allocator<Tp, N, Allocator>(other.allocator_)) {
+    init_inline();
+    this->assign(other.begin(), other.end());
+  }
+  // noexcept when Tp's move is, so that a vector of small_vectors moves
+  // them when it grows instead of copying.
+  small_vector(small_vector&& other)
+    noexcept(is_nothrow_move_constructible<Tp>::value) :
+    base(small_buffer_allocator<Tp, N, Allocator>(other.allocator_)) {
+    init_inline();
+    steal(other);
+  }
+
+  small_vector& operator=(const small_vector& other) {
+    base::operator=(other);
+    return *this;
+  }
+  small_vector& operator=(small_vector&& other)
+    noexcept(is_nothrow_move_constructible<Tp>::value) {
+    if (&other != this) {
+      this->destroy_and_deallocate();
+      init_inline();
+      steal(other);
+    }
+    return *this;
+  }
+
+  bool is_inline() const {
+    return this->start_ ==
+      const_cast<small_vector*>(this)->allocator_.inline_data();
+  }
+
+  // Moves the elements back into the inline buffer when they fit.
+  void shrink_to_fit() { shrink_to(this->size()); }
+  void shrink_to(size_type n) {
+    if (is_inline()) return;
+    if (n > N || this->size() > N) {
+      base::shrink_to(n);
+      return;
+    }
+    iterator old_start = this->start_, old_finish = this->finish_;
+    size_type old_capacity = this->capacity();
+    this->start_ = this->allocator_.acquire_inline();
+    this->finish_ = this->relocate(old_start, old_finish, this->start_);
+    this->end_of_storage_ = this->start_ + N;
+    this->destroy_relocated(old_start, old_finish);
+    this->allocator_.deallocate(old_start, old_capacity);
+  }
+
+  void swap(small_vector& other) {
+    small_vector tmp(mystl::move(other));
+    other = mystl::move(*this);
+    *this = mystl::move(tmp);
+  }
+
+protected:
+  void init_inline() {
+    this->start_ = this->finish_ = this->allocator_.acquire_inline();
+    this->end_of_storage_ = this->start_ + N;
+  }
+  // Takes over the elements of other. *this must be empty and inline.
+  void steal(small_vector& other) {
+    if (other.is_inline()) {
+      this->finish_ = mystl::uninitialized_move(
+        other.start_, other.finish_, this->start_);
+      other.clear();
+    } else {
+      this->allocator_.deallocate(this->start_, N);
+      this->start_ = other.start_;
+      this->finish_ = other.finish_;
+      this->end_of_storage_ = other.end_of_storage_;
+      other.init_inline();
+    }
+  }
+};
+
+template <typename Tp, size_t N, typename Allocator, typename GrowthPolicy>
+const typename small_vector<Tp, N, Allocator, GrowthPolicy>::size_type
+small_vector<Tp, N, Allocator, GrowthPolicy>::inline_capacity;
+
+}  // namespace mystl
+
+#endif  // MYSTL_SMALL_VECTOR_H
@@ -0,0 +1,573 @@
+/*
+ * Copyright 2016 Waizung Taam
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ==== Structure-of-arrays vector ====
+ *
+ * soa_vector<Fields...> stores records of several fields column by
+ * column: every field lives in its own vector<Field>, so a loop over one
+ * field streams through a contiguous array and never loads the others.
+ *
+ *   mystl::soa_vector<long, double, int> v;     // id, price, quantity
+ *   v.push_back(1, 9.5, 3);
+ *   mystl::span<double> prices = v.column<1>();
+ *   for (size_t i = 0; i < prices.size(); ++i) prices[i] *= 1.1;
+ *
+ * Row-wise code keeps working through proxies: v[i] and *it yield a
+ * soa_reference that reads and writes the fields of row i with get<I>(),
+ * or get<Field>() when the field types are distinct, assigns from and
+ * converts to the value type soa_tuple<Fields...>, and can be swapped.
+ *
+ * The columns grow together: before a column would reallocate, all of
+ * them reserve the same capacity, chosen by double_growth for the size
+ * of a whole row. A row is appended column by column and, if a field
+ * constructor throws, the fields already appended are removed again.
+ */
+
+/* - index_sequence<Is...>, make_index_sequence<N>
+ * - type_at<I, Types...>, index_of<Tp, Types...>
+ * - soa_tuple<Fields...>
+ * - soa_reference<Vector, Const>
+ * - soa_iterator<Vector, Const>
+ * - get<I>(), get<Field>()
+ * - soa_vector<Fields...>
+ *   - public
+ *     - ctors, op=, dtor
+ *     - columns
+ *     - accessors
+ *     - iterators
+ *     - capacity
+ *     - modifiers
+ *   - private
+ *     - emplace_columns()
+ *     - data members
+ * - comparisons of soa_vectors
+ */
+#ifndef MYSTL_SOA_VECTOR_H
+#define MYSTL_SOA_VECTOR_H
+
+#include "span.h"
+
+namespace mystl {
+
+template <size_t... Is>
+struct index_sequence {};
+template <size_t N, size_t... Is>
+struct make_index_sequence_aux :
+  make_index_sequence_aux<N - 1, N - 1, Is...> {};
+template <size_t... Is>
+struct make_index_sequence_aux<0, Is...> {
+  typedef index_sequence<Is...> type;
+};
+template <size_t N>
+using make_index_sequence = typename make_index_sequence_aux<N>::type;
+
+template <size_t I, typename... Types> struct type_at;
+template <typename Head, typename... Tail>
+struct type_at<0, Head, Tail...> { typedef Head type; };
+template <size_t I, typename Head, typename... Tail>
+struct type_at<I, Head, Tail...> : type_at<I - 1, Tail...> {};
+
+// Position of the first Tp in Types.
+template <typename Tp, typename... Types> struct index_of;
+template <typename Tp, typename... Tail>
+struct index_of<Tp, Tp, Tail...> { static const size_t value = 0; };
+template <typename Tp, typename Head, typename... Tail>
+struct index_of<Tp, Head, Tail...> {
+  static const size_t value = 1 + index_of<Tp, Tail...>::value;
+};
+
+/* soa_tuple
+ * The value type of a row: one field per base class, so that get<I>() is
+ * a static_cast. soa_columns has the same shape with a vector per field.
+ */
+template <size_t I, typename Field>
+struct soa_element {
+  soa_element() : value() {}
+  template <typename Arg>
+  explicit soa_element(Arg&& arg) : value(mystl::forward<Arg>(arg)) {}
+  Field value;
+};
+
+template <typename Indices, typename... Fields> struct soa_tuple_impl;
+template <size_t... Is, typename... Fields>
+struct soa_tuple_impl<index_sequence<Is...>, Fields...> :
+  soa_element<Is, Fields>... {
+  soa_tuple_impl() {}
+  template <typename... Args>
+  explicit soa_tuple_impl(Args&&... args) :
+    soa_element<Is, Fields>(mystl::forward<Args>(args))... {}
+};
+
+template <typename... Fields>
+class soa_tuple :
+  public soa_tuple_impl<make_index_sequence<sizeof...(Fields)>, Fields...> {
+  typedef soa_tuple_impl<make_index_sequence<sizeof...(Fields)>, Fields...>
+          base;
+public:
+  soa_tuple() {}
+  soa_tuple(const Fields&... fields) : base(fields...) {}
+};
+
+template <size_t I, typename... Fields>
+inline typename type_at<I, Fields...>::type& get(soa_tuple<Fields...>& t) {
+  return static_cast<soa_element<I, typename type_at<I, Fields...>::type>&>(
+    t).value;
+}
+template <size_t I, typename... Fields>
+inline const typename type_at<I, Fields...>::type&
+get(const soa_tuple<Fields...>& t) {
+  return static_cast<const soa_element<
+    I, typename type_at<I, Fields...>::type>&>(t).value;
+}
+template <typename Field, typename... Fields>
+inline Field& get(soa_tuple<Fields...>& t) {
+  return get<index_of<Field, Fields...>::value>(t);
+}
+template <typename Field, typename... Fields>
+inline const Field& get(const soa_tuple<Fields...>& t) {
+  return get<index_of<Field, Fields...>::value>(t);
+}
+
+template <size_t I, typename Field>
+struct soa_column {
+  vector<Field> values;
+};
+template <typename Indices, typename... Fields> struct soa_columns;
+template <size_t... Is, typename... Fields>
+struct soa_columns<index_sequence<Is...>, Fields...> :
+  soa_column<Is, Fields>... {};
+
+template <typename... Fields> class soa_vector;
+
+/* soa_reference
+ * Row pos of a soa_vector. Like vector<bool>::reference it is a value
+ * that stands for an element: copying it copies the position, assigning
+ * to it assigns the fields.
+ */
+template <typename Vector, bool Const>
+class soa_reference {
+public:
+  typedef typename conditional<Const, const Vector, Vector>::type
+          vector_type;
+  typedef typename Vector::value_type value_type;
+
+  soa_reference(vector_type* v, size_t pos) : vector_(v), pos_(pos) {}
+  // reference -> const_reference
+  soa_reference(const soa_reference<Vector, false>& other) :
+    vector_(other.owner()), pos_(other.position()) {}
+
+  soa_reference& operator=(const value_type& value) {
+    assign(value, make_index_sequence<Vector::field_count>());
+    return *this;
+  }
+  soa_reference& operator=(const soa_reference& other) {
+    return *this = value_type(other);
+  }
+  operator value_type() const {
+    return convert(make_index_sequence<Vector::field_count>());
+  }
+
+  vector_type* owner() const { return vector_; }
+  size_t position() const { return pos_; }
+
+private:
+  template <size_t... Is>
+  void assign(const value_type& value, index_sequence<Is...>) {
+    int expand[] = {(vector_->template values<Is>()[pos_] =
+                     get<Is>(value), 0)...};
+    (void)expand;
+  }
+  template <size_t... Is>
+  value_type convert(index_sequence<Is...>) const {
+    return value_type(vector_->template values<Is>()[pos_]...);
+  }
+
+  vector_type* vector_;
+  size_t pos_;
+};
+
+template <size_t I, typename Vector, bool Const>
+inline typename conditional<Const,
+  const typename Vector::template field_type<I>::type&,
+  typename Vector::template field_type<I>::type&>::type
+get(const soa_reference<Vector, Const>& r) {
+  return r.owner()->template values<I>()[r.position()];
+}
+template <typename Field, typename Vector, bool Const>
+inline typename conditional<Const, const Field&, Field&>::type
+get(const soa_reference<Vector, Const>& r) {
+  return get<Vector::template field_index<Field>::value>(r);
+}
+
+template <typename Vector>
+inline void swap(soa_reference<Vector, false> x,
+                 soa_reference<Vector, false> y) {
+  typename Vector::value_type tmp = x;
+  x = y;
+  y = tmp;
+}
+
+/* soa_iterator
+ * A row index. Dereferencing yields a soa_reference, so the iterator has
+ * no operator->.
+ */
+template <typename Vector, bool Const>
+class soa_iterator {
+public:
+  typedef random_access_iterator_tag iterator_category;
+  typedef typename Vector::value_type value_type;
+  typedef ptrdiff_t difference_type;
+  typedef void pointer;
+  typedef soa_reference<Vector, Const> reference;
+  typedef typename reference::vector_type vector_type;
+
+  soa_iterator() : vector_(0), pos_(0) {}
+  soa_iterator(vector_type* v, size_t pos) : vector_(v), pos_(pos) {}
+  // iterator -> const_iterator
+  soa_iterator(const soa_iterator<Vector, false>& other) :
+    vector_(other.owner()), pos_(other.position()) {}
+
+  vector_type* owner() const { return vector_; }
+  size_t position() const { return pos_; }
+
+  reference operator*() const { return reference(vector_, pos_); }
+  reference operator[](difference_type n) const {
+    return reference(vector_, pos_ + n);
+  }
+
+  soa_iterator& operator++() {
+    ++pos_;
+    return *this;
+  }
+  soa_iterator operator++(int) {
+    soa_iterator tmp = *this;
+    ++pos_;
+    return tmp;
+  }
+  soa_iterator& operator--() {
+    --pos_;
+    return *this;
+  }
+  soa_iterator operator--(int) {
+    soa_iterator tmp = *this;
+    --pos_;
+    return tmp;
+  }
+  soa_iterator& operator+=(difference_type n) {
+    pos_ += n;
+    return *this;
+  }
+  soa_iterator& operator-=(difference_type n) {
+    pos_ -= n;
+    return *this;
+  }
+  soa_iterator operator+(difference_type n) const {
+    return soa_iterator(vector_, pos_ + n);
+  }
+  soa_iterator operator-(difference_type n) const {
+    return soa_iterator(vector_, pos_ - n);
+  }
+  difference_type operator-(const soa_iterator& other) const {
+    return difference_type(pos_ - other.pos_);
+  }
+
+  bool operator==(const soa_iterator& other) const {
+    return pos_ == other.pos_;
+  }
+  bool operator!=(const soa_iterator& other) const {
+    return pos_ != other.pos_;
+  }
+  bool operator<(const soa_iterator& other) const {
+    return pos_ < other.pos_;
+  }
+  bool operator>(const soa_iterator& other) const {
+    return pos_ > other.pos_;
+  }
+  bool operator<=(const soa_iterator& other) const {
+    return pos_ <= other.pos_;
+  }
+  bool operator>=(const soa_iterator& other) const {
+    return pos_ >= other.pos_;
+  }
+
+private:
+  vector_type* vector_;
+  size_t pos_;
+};
+
+template <typename... Fields>
+class soa_vector {
+  static_assert(sizeof...(Fields) > 0, "soa_vector needs a field");
+  typedef make_index_sequence<sizeof...(Fields)> indices;
+
+public:
+  static const size_t field_count = sizeof...(Fields);
+  template <size_t I>
+  struct field_type { typedef typename type_at<I, Fields...>::type type; };
+  template <typename Field>
+  struct field_index : index_of<Field, Fields...> {};
+
+  typedef soa_tuple<Fields...> value_type;
+  typedef size_t size_type;
+  typedef ptrdiff_t difference_type;
+  typedef soa_reference<soa_vector, false> reference;
+  typedef soa_reference<soa_vector, true> const_reference;
+  typedef soa_iterator<soa_vector, false> iterator;
+  typedef soa_iterator<soa_vector, true> const_iterator;
+  typedef mystl::reverse_iterator<iterator> reverse_iterator;
+  typedef mystl::reverse_iterator<const_iterator> const_reverse_iterator;
+
+  soa_vector() : capacity_(0) {}
+  explicit soa_vector(size_type n) : capacity_(0) { resize(n); }
+  soa_vector(size_type n, const value_type& value) : capacity_(0) {
+    resize(n, value);
+  }
+  soa_vector(const soa_vector& other) :
+    columns_(other.columns_), capacity_(other.size()) {}
+  soa_vector(soa_vector&& other) noexcept :
+    columns_(mystl::move(other.columns_)), capacity_(other.capacity_) {
+    other.capacity_ = 0;
+  }
+
+  soa_vector& operator=(const soa_vector& other) {
+    if (this != &other) {
+      // A column that fails to copy leaves the rows inconsistent.
+      try {
+        columns_ = other.columns_;
+      } catch (...) {
+        clear();
+        throw;
+      }
+      capacity_ = capacity_ < size() ? size() : capacity_;
+    }
+    return *this;
+  }
+  soa_vector& operator=(soa_vector&& other) noexcept {
+    swap(other);
+    return *this;
+  }
+
+  /* columns
+   * column<I>() views field I of all rows as one contiguous array. The
+   * view is invalidated by anything that may reallocate.
+   */
+  template <size_t I>
+  span<typename type_at<I, Fields...>::type> column() {
+    vector<typename type_at<I, Fields...>::type>& c = values<I>();
+    return span<typename type_at<I, Fields...>::type>(c.data(), c.size());
+  }
+  template <size_t I>
+  span<const typename type_at<I, Fields...>::type> column() const {
+    const vector<typename type_at<I, Fields...>::type>& c = values<I>();
+    return span<const typename type_at<I, Fields...>::type>(c.data(),
+                                                            c.size());
+  }
+  template <size_t I>
+  typename type_at<I, Fields...>::type* data() { return values<I>().data(); }
+  template <size_t I>
+  const typename type_at<I, Fields...>::type* data() const {
+    return values<I>().data();
+  }
+
+  /* accessors */
+  reference operator[](size_type pos) { return reference(this, pos); }
+  const_reference operator[](size_type pos) const {
+    return const_reference(this, pos);
+  }
+  reference at(size_type pos) {
+    if (pos >= size()) throw "Out-of-range";
+    return reference(this, pos);
+  }
+  const_reference at(size_type pos) const {
+    if (pos >= size()) throw "Out-of-range";
+    return const_reference(this, pos);
+  }
+  reference front() { return reference(this, 0); }
+  const_reference front() const { return const_reference(this, 0); }
+  reference back() { return reference(this, size() - 1); }
+  const_reference back() const { return const_reference(this, size() - 1); }
+
+  /* iterators */
+  iterator begin() { return iterator(this, 0); }
+  const_iterator begin() const { return const_iterator(this, 0); }
+  const_iterator cbegin() const { return begin(); }
+  iterator end() { return iterator(this, size()); }
+  const_iterator end() const { return const_iterator(this, size()); }
+  const_iterator cend() const { return end(); }
+  reverse_iterator rbegin() { return reverse_iterator(end()); }
+  const_reverse_iterator rbegin() const {
+    return const_reverse_iterator(end());
+  }
+  const_reverse_iterator crbegin() const { return rbegin(); }
+  reverse_iterator rend() { return reverse_iterator(begin()); }
+  const_reverse_iterator rend() const {
+    return const_reverse_iterator(begin());
+  }
+  const_reverse_iterator crend() const { return rend(); }
+
+  /* capacity */
+  size_type size() const { return values<0>().size(); }
+  bool empty() const { return size() == 0; }
+  size_type capacity() const { return capacity_; }
+  void reserve(size_type n) {
+    if (n <= capacity_) return;
+    reserve_aux(n, indices());
+    capacity_ = n;
+  }
+  void shrink_to_fit() {
+    shrink_aux(indices());
+    capacity_ = size();
+  }
+
+  /* modifiers */
+  template <typename... Args>
+  void emplace_back(Args&&... args) {
+    static_assert(sizeof...(Args) == sizeof...(Fields),
+                  "emplace_back() takes one argument per field");
+    if (size() == capacity_) {
+      reserve(double_growth::next_capacity(size(), 1, row_size()));
+    }
+    emplace_columns<0>(mystl::forward<Args>(args)...);
+  }
+  void push_back(const Fields&... fields) { emplace_back(fields...); }
+  void push_back(const value_type& value) {
+    push_back_aux(value, indices());
+  }
+  void pop_back() { pop_back_aux(indices()); }
+  void clear() { clear_aux(indices()); }
+  void resize(size_type n) { resize(n, value_type()); }
+  void resize(size_type n, const value_type& value) {
+    if (n > size()) reserve(n);
+    size_type old_size = size();
+    try {
+      resize_aux(n, value, indices());
+    } catch (...) {
+      resize_aux(old_size, value, indices());
+      throw;
+    }
+  }
+  void swap(soa_vector& other) {
+    swap_aux(other, indices());
+    mystl::swap(capacity_, other.capacity_);
+  }
+
+  // The column of field I; used by the proxies and comparisons.
+  template <size_t I>
+  vector<typename type_at<I, Fields...>::type>& values() {
+    return static_cast<soa_column<I, typename type_at<I, Fields...>::type>&>(
+      columns_).values;
+  }
+  template <size_t I>
+  const vector<typename type_at<I, Fields...>::type>& values() const {
+    return static_cast<const soa_column<
+      I, typename type_at<I, Fields...>::type>&>(columns_).values;
+  }
+
+private:
+  static size_t row_size() {
+    size_t sizes[] = {sizeof(Fields)...};
+    size_t total = 0;
+    for (size_t i = 0; i < sizeof...(Fields); ++i) total += sizes[i];
+    return total;
+  }
+
+  // Appends to column I and the ones after it, or to none of them.
+  template <size_t I>
+  void emplace_columns() {}
+  template <size_t I, typename Arg, typename... Args>
+  void emplace_columns(Arg&& arg, Args&&... args) {
+    values<I>().emplace_back(mystl::forward<Arg>(arg));
+    try {
+      emplace_columns<I + 1>(mystl::forward<Args>(args)...);
+    } catch (...) {
+      values<I>().pop_back();
+      throw;
+    }
+  }
+  template <size_t... Is>
+  void push_back_aux(const value_type& value, index_sequence<Is...>) {
+    emplace_back(get<Is>(value)...);
+  }
+
+  /* Each of these runs one statement per column: the array initializer
+   * expands the pack in order.
+   */
+  template <size_t... Is>
+  void reserve_aux(size_type n, index_sequence<Is...>) {
+    int expand[] = {(values<Is>().reserve(n), 0)...};
+    (void)expand;
+  }
+  template <size_t... Is>
+  void shrink_aux(index_sequence<Is...>) {
+    int expand[] = {(values<Is>().shrink_to_fit(), 0)...};
+    (void)expand;
+  }
+  template <size_t... Is>
+  void pop_back_aux(index_sequence<Is...>) {
+    int expand[] = {(values<Is>().pop_back(), 0)...};
+    (void)expand;
+  }
+  template <size_t... Is>
+  void clear_aux(index_sequence<Is...>) {
+    int expand[] = {(values<Is>().clear(), 0)...};
+    (void)expand;
+  }
+  template <size_t... Is>
+  void resize_aux(size_type n, const value_type& value,
+                  index_sequence<Is...>) {
+    int expand[] = {(values<Is>().resize(n, get<Is>(value)), 0)...};
+    (void)expand;
+  }
+  template <size_t... Is>
+  void swap_aux(soa_vector& other, index_sequence<Is...>) {
+    int expand[] = {(values<Is>().swap(other.template values<Is>()), 0)...};
+    (void)expand;
+  }
+
+  /* data members
+   * capacity_ is the capacity every column has reserved; a column may
+   * have more after a failed reserve().
+   */
+  soa_columns<indices, Fields...> columns_;
+  size_type capacity_;
+};
+
+template <typename... Fields>
+inline bool soa_equal(const soa_vector<Fields...>& x,
+                      const soa_vector<Fields...>& y, index_sequence<>) {
+  return true;
+}
+template <typename... Fields, size_t I, size_t... Is>
+inline bool soa_equal(const soa_vector<Fields...>& x,
+                      const soa_vector<Fields...>& y,
+                      index_sequence<I, Is...>) {
+  return x.template values<I>() == y.template values<I>() &&
+         soa_equal(x, y, index_sequence<Is...>());
+}
+template <typename... Fields>
+bool operator==(const soa_vector<Fields...>& x,
+                const soa_vector<Fields...>& y) {
+  return soa_equal(x, y, make_index_sequence<sizeof...(Fields)>());
+}
+template <typename... Fields>
+bool operator!=(const soa_vector<Fields...>& x,
+                const soa_vector<Fields...>& y) {
+  return !(x == y);
+}
+
+}  // namespace mystl
+
+#endif  // MYSTL_SOA_VECTOR_H
@@ -0,0 +1,504 @@
+/*
+ * Copyright 2016 Waizung Taam
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ==== Sorted vector: the common part of flat_set and flat_map ====
+ *
+ * sorted_vector keeps unique elements in a vector, ordered by the key
+ * that KeyOf extracts from each of them. flat_set and flat_map derive
+ * from it.
+ *
+ * Lookups are branchless binary searches: every step halves the range
+ * with a conditional move instead of a jump, so searching does not
+ * mispredict and its loads can be issued early.
+ *
+ * Inserting one element shifts the tail like vector::insert(). To add
+ * many, insert_sorted() merges a sorted range with the elements in one
+ * pass, and insert(first, last) sorts the range and then merges it.
+ *
+ * For large tables that are read far more often than written,
+ * build_index() adds an Eytzinger index: a copy of the keys laid out in
+ * breadth-first order of the binary search tree, so that the first
+ * levels of every search share a few cache lines and the next ones can
+ * be prefetched. Lookups use it until the next modification drops it.
+ */
+
+/* - pair<T1, T2>, make_pair()
+ * - less<Tp>
+ * - identity_key, select_first
+ * - sorted_unique_t
+ * - branchless_partition_point()
+ * - stable_sort_vector()
+ * - eytzinger_index<Key, Compare, Allocator>
+ * - sorted_vector<Value, Key, KeyOf, Compare, Allocator, MutableValues>
+ *   - public
+ *     - get_allocator()
+ *     - iterators
+ *     - capacity
+ *     - lookup
+ *     - modifiers
+ *     - build_index(), drop_index(), has_index()
+ *     - sequence()
+ *   - protected
+ *     - ctors
+ *     - lower_bound_index(), upper_bound_index(), find_index()
+ *     - merge()
+ *     - data members
+ * - comparisons of sorted_vectors
+ */
+#ifndef MYSTL_SORTED_VECTOR_H
+#define MYSTL_SORTED_VECTOR_H
+
+#include "vector.h"
+
+namespace mystl {
+
+template <typename T1, typename T2>
+struct pair {
+  typedef T1 first_type;
+  typedef T2 second_type;
+
+  pair() : first(), second() {}
+  pair(const T1& x, const T2& y) : first(x), second(y) {}
+  template <typename U1, typename U2>
+  pair(U1&& x, U2&& y) :
+    first(mystl::forward<U1>(x)), second(mystl::forward<U2>(y)) {}
+  template <typename U1, typename U2>
+  pair(const pair<U1, U2>& other) : first(other.first), second(other.second) {}
+
+  T1 first;
+  T2 second;
+};
+template <typename T1, typename T2>
+inline pair<T1, T2> make_pair(const T1& x, const T2& y) {
+  return pair<T1, T2>(x, y);
+}
+template <typename T1, typename T2>
+inline bool operator==(const pair<T1, T2>& x, const pair<T1, T2>& y) {
+  return x.first == y.first && x.second == y.second;
+}
+template <typename T1, typename T2>
+inline bool operator!=(const pair<T1, T2>& x, const pair<T1, T2>& y) {
+  return !(x == y);
+}
+template <typename T1, typename T2>
+inline bool operator<(const pair<T1, T2>& x, const pair<T1, T2>& y) {
+  return x.first < y.first || (!(y.first < x.first) && x.second < y.second);
+}
+template <typename T1, typename T2>
+struct is_trivially_relocatable<pair<T1, T2>> :
+  bool_type<is_trivially_relocatable<T1>::value &&
+            is_trivially_relocatable<T2>::value> {};
+
+template <typename Tp>
+struct less {
+  bool operator()(const Tp& x, const Tp& y) const { return x < y; }
+};
+
+// Key extractors: a set element is its own key, a map element a pair.
+struct identity_key {
+  template <typename Tp>
+  const Tp& operator()(const Tp& x) const { return x; }
+};
+struct select_first {
+  template <typename Pair>
+  const typename Pair::first_type& operator()(const Pair& x) const {
+    return x.first;
+  }
+};
+
+// Tells a constructor that the elements are already sorted and unique.
+struct sorted_unique_t {};
+static const sorted_unique_t sorted_unique = sorted_unique_t();
+
+/* Returns the first element of [first, first + n) for which pred is
+ * false, given that pred is true for a prefix of the range and false for
+ * the rest. The loop runs exactly ceil(log2(n)) times and selects the
+ * next half with a conditional move.
+ */
+template <typename Tp, typename Predicate>
+inline const Tp* branchless_partition_point(const Tp* first, size_t n,
+                                            Predicate pred) {
+  if (n == 0) return first;
+  while (n > 1) {
+    size_t half = n / 2;
+    first = pred(first[half]) ? first + half : first;
+    n -= half;
+  }
+  return first + pred(*first);
+}
+
+/* Sorts v by key, keeping equal keys in their original order: insertion
+ * sort on runs of 16, then merges of doubling width between v and a
+ * buffer.
+ */
+template <typename Tp, typename Allocator, typename GrowthPolicy,
+          typename KeyOf, typename Compare>
+void stable_sort_vector(vector<Tp, Allocator, GrowthPolicy>& v,
+                        KeyOf key_of, Compare comp) {
+  const size_t run = 16;
+  size_t n = v.size();
+  if (n < 2) return;
+  Tp* data = v.data();
+  for (size_t begin = 0; begin < n; begin += run) {
+    size_t end = begin + run < n ? begin + run : n;
+    for (size_t i = begin + 1; i < end; ++i) {
+      if (!comp(key_of(data[i]), key_of(data[i - 1]))) continue;
+      Tp x = mystl::move(data[i]);
+      size_t j = i;
+      for (; j > begin && comp(key_of(x), key_of(data[j - 1])); --j) {
+        data[j] = mystl::move(data[j - 1]);
+      }
+      data[j] = mystl::move(x);
+    }
+  }
+  if (n <= run) return;
+  vector<Tp, Allocator, GrowthPolicy> buffer(v.get_allocator());
+  buffer.reserve(n);
+  for (size_t i = 0; i < n; ++i) buffer.push_back(mystl::move(data[i]));
+  Tp* from = buffer.data();
+  Tp* to = data;
+  // Each pass merges runs from one array into the other, starting from
+  // the buffer; the result is moved back if it ends up there.
+  for (size_t width = run; width < n; width *= 2) {
+    for (size_t begin = 0; begin < n; begin += 2 * width) {
+      size_t middle = begin + width < n ? begin + width : n;
+      size_t end = begin + 2 * width < n ? begin + 2 * width : n;
+      size_t i = begin, j = middle, k = begin;
+      while (i < middle && j < end) {
+        if (comp(key_of(from[j]), key_of(from[i]))) {
+          to[k++] = mystl::move(from[j++]);
+        } else {
+          to[k++] = mystl::move(from[i++]);
+        }
+      }
+      while (i < middle) to[k++] = mystl::move(from[i++]);
+      while (j < end) to[k++] = mystl::move(from[j++]);
+    }
+    Tp* tmp = from;
+    from = to;
+    to = tmp;
+  }
+  if (from != data) {
+    for (size_t i = 0; i < n; ++i) data[i] = mystl::move(from[i]);
+  }
+}
+
+/* eytzinger_index
+ * The keys of a sorted sequence stored in the order of a breadth-first
+ * walk of the implicit binary search tree over it: node k (from 1) has
+ * children 2k and 2k + 1. A search descends with k = 2k + (key > node),
+ * so the first levels of every search share a few cache lines, and it
+ * prefetches the nodes four levels down while comparing. The position
+ * of a node in the sorted sequence follows from k and the size, so the
+ * index holds nothing but the keys.
+ */
+template <typename Key, typename Compare, typename Allocator>
+class eytzinger_index {
+  typedef typename Allocator::template rebind<Key>::other key_allocator;
+
+public:
+  explicit eytzinger_index(const Allocator& alloc) :
+    keys_(key_allocator(alloc)) {}
+
+  template <typename Tp, typename KeyOf>
+  void build(const Tp* sorted, size_t n, KeyOf key_of) {
+    clear();
+    keys_.reserve(n);
+    for (size_t k = 1; k <= n; ++k) {
+      keys_.push_back(key_of(sorted[rank_of(k, n)]));
+    }
+  }
+  void clear() { keys_.clear(); }
+  bool empty() const { return keys_.empty(); }
+  size_t size() const { return keys_.size(); }
+
+  /* The sorted position of the first key not less than key, or size().
+   * found tells whether that key equals key.
+   */
+  size_t lower_bound(const Key& key, Compare comp, bool& found) const {
+    size_t n = keys_.size();
+    const Key* keys = keys_.data() - 1;  // 1-based
+    size_t k = 1;
+    // All levels but the last are full: descend through them a fixed
+    // number of times, so that the loop exit is predicted, then take the
+    // last step only if the node exists, without a branch.
+    for (int levels = 63 - __builtin_clzl(n); levels > 0; --levels) {
+      __builtin_prefetch(keys + (16 * k < n ? 16 * k : n));
+      k = 2 * k + comp(keys[k], key);
+    }
+    size_t last = k <= n ? k : 1;
+    size_t next = 2 * k + comp(keys[last], key);
+    k = k <= n ? next : k;
+    // Undo the right turns taken after the last left turn.
+    k >>= __builtin_ctzl(~k) + 1;
+    if (k == 0) {
+      found = false;
+      return n;
+    }
+    found = !comp(key, keys[k]);
+    return rank_of(k, n);
+  }
+
+private:
+  /* The in-order position of node k in a tree of n nodes: its position
+   * p in the perfect tree of the same height, less the missing leaves
+   * before it. The leaves sit at the even positions and the present
+   * ones come first.
+   */
+  static size_t rank_of(size_t k, size_t n) {
+    int height = 64 - __builtin_clzl(n);
+    int depth = 63 - __builtin_clzl(k);
+    size_t p = ((2 * (k - (size_t(1) << depth)) + 1) <<
+                (height - 1 - depth)) - 1;
+    size_t leaves = n - ((size_t(1) << (height - 1)) - 1);
+    size_t leaves_before = (p + 1) / 2;
+    return leaves_before > leaves ? p - (leaves_before - leaves) : p;
+  }
+
+  vector<Key, key_allocator> keys_;
+};
+
+template <typename Value, typename Key, typename KeyOf, typename Compare,
+          typename Allocator, bool MutableValues>
+class sorted_vector {
+public:
+  typedef Key key_type;
+  typedef Value value_type;
+  typedef Compare key_compare;
+  typedef Allocator allocator_type;
+  typedef vector<Value, Allocator> vector_type;
+  typedef size_t size_type;
+  typedef ptrdiff_t difference_type;
+  typedef typename conditional<MutableValues, Value&, const Value&>::type
+    reference;
+  typedef const Value& const_reference;
+  typedef typename conditional<MutableValues, Value*, const Value*>::type
+    iterator;
+  typedef const Value* const_iterator;
+  typedef mystl::reverse_iterator<iterator> reverse_iterator;
+  typedef mystl::reverse_iterator<const_iterator> const_reverse_iterator;
+
+  allocator_type get_allocator() const { return items_.get_allocator(); }
+
+  /* iterators */
+  iterator begin() { return items_.begin(); }
+  const_iterator begin() const { return items_.begin(); }
+  const_iterator cbegin() const { return items_.begin(); }
+  iterator end() { return items_.end(); }
+  const_iterator end() const { return items_.end(); }
+  const_iterator cend() const { return items_.end(); }
+  reverse_iterator rbegin() { return reverse_iterator(end()); }
+  const_reverse_iterator rbegin() const {
+    return const_reverse_iterator(end());
+  }
+  reverse_iterator rend() { return reverse_iterator(begin()); }
+  const_reverse_iterator rend() const {
+    return const_reverse_iterator(begin());
+  }
+
+  /* capacity */
+  size_type size() const { return items_.size(); }
+  bool empty() const { return items_.empty(); }
+  size_type max_size() const { return items_.max_size(); }
+  size_type capacity() const { return items_.capacity(); }
+  void reserve(size_type n) { items_.reserve(n); }
+  void shrink_to_fit() { items_.shrink_to_fit(); }
+
+  /* lookup */
+  iterator find(const Key& key) { return begin() + find_index(key); }
+  const_iterator find(const Key& key) const {
+    return begin() + find_index(key);
+  }
+  bool contains(const Key& key) const { return find_index(key) != size(); }
+  size_type count(const Key& key) const { return contains(key) ? 1 : 0; }
+  iterator lower_bound(const Key& key) {
+    return begin() + lower_bound_index(key);
+  }
+  const_iterator lower_bound(const Key& key) const {
+    return begin() + lower_bound_index(key);
+  }
+  iterator upper_bound(const Key& key) {
+    return begin() + upper_bound_index(key);
+  }
+  const_iterator upper_bound(const Key& key) const {
+    return begin() + upper_bound_index(key);
+  }
+  key_compare key_comp() const { return comp_; }
+
+  /* modifiers */
+  pair<iterator, bool> insert(const Value& value) {
+    size_type pos = lower_bound_index(key_of_(value));
+    if (pos != size() && !comp_(key_of_(value), key_of_(items_[pos]))) {
+      return pair<iterator, bool>(begin() + pos, false);
+    }
+    index_.clear();
+    return pair<iterator, bool>(items_.insert(items_.begin() + pos, value),
+                                true);
+  }
+  pair<iterator, bool> insert(Value&& value) {
+    size_type pos = lower_bound_index(key_of_(value));
+    if (pos != size() && !comp_(key_of_(value), key_of_(items_[pos]))) {
+      return pair<iterator, bool>(begin() + pos, false);
+    }
+    index_.clear();
+    return pair<iterator, bool>(
+      items_.insert(items_.begin() + pos, mystl::move(value)), true);
+  }
+  /* Inserts [first, last), which must be sorted by key, merging it with
+   * the elements in one pass. Elements whose key is already present, or
+   * repeats that of an earlier element of the range, are skipped.
+   * Returns the number inserted. Strong guarantee if Value's move
+   * constructor does not throw or Value is copyable.
+   */
+  template <typename ForwardIterator>
+  size_type insert_sorted(ForwardIterator first, ForwardIterator last) {
+    vector_type range(first, last, items_.get_allocator());
+    return merge(range);
+  }
+  // Like insert_sorted() for a range in any order; the first of equal
+  // keys wins.
+  template <typename InputIterator>
+  size_type insert(InputIterator first, InputIterator last) {
+    vector_type range(first, last, items_.get_allocator());
+    stable_sort_vector(range, key_of_, comp_);
+    return merge(range);
+  }
+  size_type erase(const Key& key) {
+    size_type pos = find_index(key);
+    if (pos == size()) return 0;
+    index_.clear();
+    items_.erase(items_.begin() + pos);
+    return 1;
+  }
+  iterator erase(const_iterator pos) {
+    index_.clear();
+    return items_.erase(items_.begin() + (pos - cbegin()));
+  }
+  iterator erase(const_iterator first, const_iterator last) {
+    index_.clear();
+    return items_.erase(items_.begin() + (first - cbegin()),
+                        items_.begin() + (last - cbegin()));
+  }
+  void clear() {
+    index_.clear();
+    items_.clear();
+  }
+  void swap(sorted_vector& other) {
+    items_.swap(other.items_);
+    mystl::swap(index_, other.index_);
+    mystl::swap(comp_, other.comp_);
+  }
+
+  /* Eytzinger index
+   * Costs a copy of the keys. Any insertion or erasure drops it.
+   */
+  void build_index() { index_.build(items_.data(), size(), key_of_); }
+  void drop_index() { index_.clear(); }
+  bool has_index() const { return !index_.empty(); }
+
+  // The elements, sorted by key.
+  const vector_type& sequence() const { return items_; }
+
+protected:
+  explicit sorted_vector(const Compare& comp, const Allocator& alloc) :
+    items_(alloc), index_(alloc), comp_(comp) {}
+  sorted_vector(sorted_unique_t, vector_type&& items, const Compare& comp) :
+    items_(mystl::move(items)), index_(items_.get_allocator()),
+    comp_(comp) {}
+
+  size_type lower_bound_index(const Key& key) const {
+    bool found;
+    if (!index_.empty()) return index_.lower_bound(key, comp_, found);
+    return branchless_partition_point(items_.data(), size(),
+      [&](const Value& x) { return comp_(key_of_(x), key); }) -
+      items_.data();
+  }
+  size_type upper_bound_index(const Key& key) const {
+    return branchless_partition_point(items_.data(), size(),
+      [&](const Value& x) { return !comp_(key, key_of_(x)); }) -
+      items_.data();
+  }
+  // The position of key, or size() if absent.
+  size_type find_index(const Key& key) const {
+    if (!index_.empty()) {
+      bool found;
+      size_type pos = index_.lower_bound(key, comp_, found);
+      return found ? pos : size();
+    }
+    size_type pos = lower_bound_index(key);
+    return pos != size() && !comp_(key, key_of_(items_[pos])) ? pos : size();
+  }
+
+  /* Merges the sorted range into a new buffer, moving the elements and
+   * the range over, then swaps it in. The range was copied beforehand,
+   * so nothing below can throw after an element has been moved out of
+   * items_ unless Value has a throwing move and no copy.
+   */
+  size_type merge(vector_type& range) {
+    if (range.empty()) return 0;
+    vector_type merged(items_.get_allocator());
+    merged.reserve(size() + range.size());
+    Value* i = items_.begin();
+    Value* end = items_.end();
+    for (Value* r = range.begin(); r != range.end(); ++r) {
+      const Key& key = key_of_(*r);
+      Value* run_end = const_cast<Value*>(branchless_partition_point(
+        static_cast<const Value*>(i), end - i,
+        [&](const Value& x) { return comp_(key_of_(x), key); }));
+      for (; i != run_end; ++i) {
+        merged.push_back(mystl::move_if_noexcept(*i));
+      }
+      if ((i != end && !comp_(key, key_of_(*i))) ||
+          (!merged.empty() && !comp_(key_of_(merged.back()), key))) {
+        continue;  // present already
+      }
+      merged.push_back(mystl::move(*r));
+    }
+    for (; i != end; ++i) merged.push_back(mystl::move_if_noexcept(*i));
+    size_type inserted = merged.size() - size();
+    index_.clear();
+    items_.swap(merged);
+    return inserted;
+  }
+
+  vector_type items_;
+  eytzinger_index<Key, Compare, Allocator> index_;
+  Compare comp_;
+  KeyOf key_of_;
+};
+
+template <typename Value, typename Key, typename KeyOf, typename Compare,
+          typename Allocator, bool MutableValues>
+bool operator==(
+  const sorted_vector<Value, Key, KeyOf, Compare, Allocator,
+                      MutableValues>& x,
+  const sorted_vector<Value, Key, KeyOf, Compare, Allocator,
+                      MutableValues>& y) {
+  return x.sequence() == y.sequence();
+}
+template <typename Value, typename Key, typename KeyOf, typename Compare,
+          typename Allocator, bool MutableValues>
+bool operator!=(
+  const sorted_vector<Value, Key, KeyOf, Compare, Allocator,
+                      MutableValues>& x,
+  const sorted_vector<Value, Key, KeyOf, Compare, Allocator,
+                      MutableValues>& y) {
+  return !(x == y);
+}
+
+}  // namespace mystl
+
+#endif  // MYSTL_SORTED_VECTOR_H
@@ -0,0 +1,128 @@
+/*
+ * Copyright 2016 Waizung Taam
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ==== Non-owning view of contiguous elements ====
+ *
+ * span<Tp> is a pointer and a length. It never allocates or frees, so it
+ * is only valid while the storage it views is neither freed nor moved.
+ * span<const Tp> views elements read-only.
+ *
+ * A vector converts to a span of its elements, and slicing a span makes
+ * another span, so parts of one buffer can be handed out without copies:
+ *
+ *   void sum_part(mystl::span<const long> part);
+ *   mystl::vector<long> values = ...;
+ *   mystl::span<const long> all = values;
+ *   size_t half = all.size() / 2;
+ *   sum_part(all.first(half));           // runs on one worker
+ *   sum_part(all.subspan(half));         // and this on another
+ *
+ * first(), last() and subspan() check their bounds and throw
+ * "Out-of-range", as at() does; operator[] does not check.
+ */
+
+/* - span<Tp>
+ *   - ctors
+ *   - accessors
+ *   - iterators
+ *   - slicing
+ */
+#ifndef MYSTL_SPAN_H
+#define MYSTL_SPAN_H
+
+#include "vector.h"
+
+namespace mystl {
+
+template <typename Tp>
+class span {
+public:
+  typedef Tp element_type;
+  typedef typename remove_const<Tp>::type value_type;
+  typedef size_t size_type;
+  typedef ptrdiff_t difference_type;
+  typedef Tp& reference;
+  typedef Tp* pointer;
+  typedef Tp* iterator;
+  typedef mystl::reverse_iterator<iterator> reverse_iterator;
+
+  /* ctors */
+  span() : data_(0), size_(0) {}
+  span(Tp* data, size_type size) : data_(data), size_(size) {}
+  template <size_type N>
+  span(Tp (&array)[N]) : data_(array), size_(N) {}
+  template <typename Allocator, typename GrowthPolicy>
+  span(vector<value_type, Allocator, GrowthPolicy>& v) :
+    data_(v.data()), size_(v.size()) {}
+  // Only span<const Tp> can view a const vector.
+  template <typename Allocator, typename GrowthPolicy>
+  span(const vector<value_type, Allocator, GrowthPolicy>& v) :
+    data_(v.data()), size_(v.size()) {}
+  /* span<Tp> converts to span<const Tp>, and to nothing else: a
+   * span<Base> over Derived elements would index with the wrong stride.
+   * For a non-const Tp this is the copy constructor.
+   */
+  span(const span<value_type>& other) :
+    data_(other.data()), size_(other.size()) {}
+
+  /* accessors */
+  pointer data() const { return data_; }
+  size_type size() const { return size_; }
+  size_type size_bytes() const { return size_ * sizeof(Tp); }
+  bool empty() const { return size_ == 0; }
+
+  reference operator[](size_type pos) const { return data_[pos]; }
+  reference at(size_type pos) const {
+    if (pos >= size_) throw "Out-of-range";
+    return data_[pos];
+  }
+  reference front() const { return data_[0]; }
+  reference back() const { return data_[size_ - 1]; }
+
+  /* iterators */
+  iterator begin() const { return data_; }
+  iterator end() const { return data_ + size_; }
+  reverse_iterator rbegin() const { return reverse_iterator(end()); }
+  reverse_iterator rend() const { return reverse_iterator(begin()); }
+
+  /* slicing */
+  // The first or last n elements.
+  span first(size_type n) const {
+    if (n > size_) throw "Out-of-range";
+    return span(data_, n);
+  }
+  span last(size_type n) const {
+    if (n > size_) throw "Out-of-range";
+    return span(data_ + (size_ - n), n);
+  }
+  // The elements from offset on, or n of them.
+  span subspan(size_type offset) const {
+    if (offset > size_) throw "Out-of-range";
+    return span(data_ + offset, size_ - offset);
+  }
+  span subspan(size_type offset, size_type n) const {
+    if (offset > size_ || n > size_ - offset) throw "Out-of-range";
+    return span(data_ + offset, n);
+  }
+
+private:
+  Tp* data_;
+  size_type size_;
+};
+
+}  // namespace mystl
+
+#endif  // MYSTL_SPAN_H
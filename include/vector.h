@@ -18,7 +18,8 @@
  *
  * To show every detail of the implementation, a minimal set of helper
  * functions and classes in namespace std are defined directly in this file,  
- * therefore no standard library is needed. Note that these helper 
+ * therefore no standard library is needed apart from <new>, which declares
+ * placement new, and <immintrin.h> for the SIMD kernels on x86. Note that these helper 
  * functions are simplified, thus they will be less efficient than
  * the standard implementations, and some special cases are not covered.
  *
@@ -31,14 +32,29 @@
  *
  * - size_t, ptrdiff_t
  * - swap()
- * - move()
- * - copy(), copy_backward()
+ * - move(), forward(), move_if_noexcept()
+ * - is_integral<Tp>
+ * - is_trivially_copyable<Tp>, is_trivially_destructible<Tp>
+ * - is_nothrow_move_constructible<Tp>, is_copy_constructible<Tp>
+ * - is_trivially_relocatable<Tp>
+ * - conditional<Cond, Then, Else>
+ * - remove_const<Tp>
+ * - bulk-memory kernels for trivially copyable types
+ * - mismatch kernels (scalar, SSE2, AVX2)
+ * - copy(), copy_backward(), move(), move_backward()
  * - fill(), fill_n()
  * - uninitialized_copy(), uninitialized_fill(), uninitialized_fill_n()
- * - is_integral<Tp>
+ * - uninitialized_move(), uninitialized_move_if_noexcept()
  * - new_allocator<Tp>
+ * - allocator_traits<Allocator>
+ * - growth policies
+ *   - double_growth, one_and_half_growth
+ *   - size_class_growth<GrowthPolicy>, huge_page_growth<GrowthPolicy>
+ *   - trimming_growth<GrowthPolicy, Num, Den>
  * 
- * - vector<Tp, Allocator>
+ * - vector_stats<Tp> (no-op unless MYSTL_VECTOR_STATS)
+ * 
+ * - vector<Tp, Allocator, GrowthPolicy>
  *   - public
  *     - ctors, op=, dtor
  *     - get_allocator()
@@ -49,20 +65,37 @@
  *     - modifiers
  *   - protected
  *     - initialize_aux()
- *     - range_initialize()
- *     - allocate_and_copy()
- *     - destroy_and_deallocate()
+ *     - fill_initialize(), range_initialize()
+ *     - allocate(), allocate_and_copy(), allocate_and_move()
+ *     - relocate(), destroy_relocated()
+ *     - open_gap(), close_gap(), fill_gap(), copy_into_gap()
+ *     - remove_from(), index_predicate<InputIterator>
+ *     - steal(), move_from(), move_assign()
+ *     - copy_assign_allocator(), swap_allocator()
+ *     - destroy_and_deallocate(), deallocate(), replace_storage()
+ *     - reallocate(), expand_in_place()
  *     - assign_aux()
+ *     - next_capacity(), reserve_for_append(), auto_trim()
  *     - range_check()
+ *     - emplace_aux()
  *     - insert_aux()
  *     - range_insert()
  *     - data members
  * - comparisons of vectors
+ * - vector<bool> (bit_vector.h)
  */
 #ifndef MYSTL_VECTOR_H
 #define MYSTL_VECTOR_H
 
+#include <new>  // placement new
+#if defined(__SSE2__)
+#include <immintrin.h>  // SSE2 / AVX2 intrinsics
+#endif
+
 #include "iterator.h"
+#ifdef MYSTL_VECTOR_STATS
+#include "vector_stats.h"
+#endif
 
 namespace mystl {
 
@@ -86,6 +119,203 @@ template <typename Tp>
 typename remove_reference<Tp>::type&& move(Tp&& x) noexcept {
   return static_cast<typename remove_reference<Tp>::type&&>(x);
 }
+template <typename Tp>
+Tp&& forward(typename remove_reference<Tp>::type& x) noexcept {
+  return static_cast<Tp&&>(x);
+}
+template <typename Tp>
+Tp&& forward(typename remove_reference<Tp>::type&& x) noexcept {
+  return static_cast<Tp&&>(x);
+}
+
+/* Note: Variant */
+struct true_type { typedef true_type type; static const bool value = true; };
+struct false_type { 
+  typedef false_type type; static const bool value = false; };
+template <typename Tp> struct is_integral { 
+  typedef false_type type; static const bool value = false; };
+template <> struct is_integral<bool> {
+  typedef true_type type;  static const bool value = true; };
+template <> struct is_integral<char> {
+  typedef true_type type;  static const bool value = true; };
+template <> struct is_integral<signed char> {
+  typedef true_type type; static const bool value = true; };
+template <> struct is_integral<unsigned char> {
+  typedef true_type type;  static const bool value = true; };
+template <> struct is_integral<wchar_t> {
+  typedef true_type type;  static const bool value = true; };
+template <> struct is_integral<short> {
+  typedef true_type type; static const bool value = true; };
+template <> struct is_integral<unsigned short> {
+  typedef true_type type;  static const bool value = true; };
+template <> struct is_integral<int> {
+  typedef true_type type;  static const bool value = true; };
+template <> struct is_integral<unsigned int> {
+  typedef true_type type;  static const bool value = true; };
+template <> struct is_integral<long> {
+  typedef true_type type;  static const bool value = true; };
+template <> struct is_integral<unsigned long> {
+  typedef true_type type;  static const bool value = true; };
+template <> struct is_integral<long long> {
+  typedef true_type type;  static const bool value = true; };
+template <> struct is_integral<unsigned long long> { 
+  typedef true_type type;  static const bool value = true; };
+
+/* Note: Variant
+ * The traits below are answered by compiler builtins (supported by both
+ * GCC and Clang), so that no <type_traits> is needed.
+ */
+template <bool Cond> struct bool_type {
+  typedef false_type type; static const bool value = false; };
+template <> struct bool_type<true> {
+  typedef true_type type;  static const bool value = true; };
+template <typename Tp> struct is_trivially_copyable : 
+  bool_type<__is_trivially_copyable(Tp)> {};
+template <typename Tp> struct is_trivially_destructible : 
+  bool_type<__has_trivial_destructor(Tp)> {};
+template <typename Tp> struct is_nothrow_move_constructible : 
+  bool_type<__is_nothrow_constructible(Tp, Tp&&)> {};
+template <typename Tp> struct is_copy_constructible : 
+  bool_type<__is_constructible(Tp, const Tp&)> {};
+/* is_trivially_relocatable<Tp>
+ * True if an object can be moved to a new address by copying its bytes, 
+ * the old copy being forgotten without running its destructor. Trivially
+ * copyable types are; specialize it for types that merely own memory 
+ * through pointers, such as handles or mystl::vector itself, but not for
+ * types that point into themselves (libstdc++'s std::string does, for its
+ * short string buffer).
+ */
+template <typename Tp> struct is_trivially_relocatable : 
+  is_trivially_copyable<Tp> {};
+template <bool Cond, typename Then, typename Else> 
+struct conditional { typedef Then type; };
+template <typename Then, typename Else> 
+struct conditional<false, Then, Else> { typedef Else type; };
+template <typename Tp> struct remove_const { typedef Tp type; };
+template <typename Tp> struct remove_const<const Tp> { typedef Tp type; };
+
+template <typename Tp>
+inline typename conditional<
+  !is_nothrow_move_constructible<Tp>::value && 
+  is_copy_constructible<Tp>::value, const Tp&, Tp&&>::type
+move_if_noexcept(Tp& x) noexcept {
+  return mystl::move(x);
+}
+
+/* Bulk-memory kernels
+ * Ranges of trivially copyable objects can be copied and filled as raw
+ * bytes. The pointer overloads of copy(), fill() and the uninitialized
+ * variants below dispatch to these kernels, other iterators keep using
+ * the element-by-element loops.
+ */
+template <typename Tp>
+inline Tp* copy_trivial(const Tp* first, const Tp* last, Tp* result) {
+  size_t n = last - first;
+  if (n != 0) __builtin_memmove(result, first, n * sizeof(Tp));
+  return result + n;
+}
+template <typename Tp>
+inline Tp* copy_backward_trivial(const Tp* first, const Tp* last, 
+                                 Tp* result) {
+  size_t n = last - first;
+  if (n != 0) __builtin_memmove(result - n, first, n * sizeof(Tp));
+  return result - n;
+}
+template <typename Tp>
+inline bool is_byte_uniform(const Tp& value) {
+  const unsigned char* p = reinterpret_cast<const unsigned char*>(&value);
+  for (size_t i = 1; i < sizeof(Tp); ++i) {
+    if (p[i] != p[0]) return false;
+  }
+  return true;
+}
+template <typename Tp>
+inline Tp* fill_trivial(Tp* first, size_t n, const Tp& value) {
+  if (is_byte_uniform(value)) {
+    if (n != 0) {
+      __builtin_memset(first, *reinterpret_cast<const unsigned char*>(&value),
+                       n * sizeof(Tp));
+    }
+    return first + n;
+  }
+  const Tp tmp = value;  // value may live inside [first, first + n)
+  for (; n > 0; --n, ++first) {
+    __builtin_memcpy(first, &tmp, sizeof(Tp));
+  }
+  return first;
+}
+
+/* Mismatch kernels
+ * mismatch_bytes() returns the offset of the first byte at which two 
+ * buffers differ, or n if they are equal. Integral elements have no 
+ * padding and equal elements have equal bytes, so the element holding 
+ * that byte is the first mismatching element of the two ranges.
+ *
+ * On x86 short buffers are compared with SSE2, which every x86-64 CPU 
+ * has; longer ones go through a function pointer chosen once at run time,
+ * which selects the AVX2 kernel when the CPU supports it. Both kernels
+ * handle a partial last block with one overlapping load.
+ */
+inline size_t mismatch_bytes_scalar(const unsigned char* x, 
+                                    const unsigned char* y, size_t n) {
+  size_t i = 0;
+  for (; i + sizeof(unsigned long) <= n; i += sizeof(unsigned long)) {
+    unsigned long a, b;
+    __builtin_memcpy(&a, x + i, sizeof(a));
+    __builtin_memcpy(&b, y + i, sizeof(b));
+    if (a != b) break;
+  }
+  for (; i < n; ++i) {
+    if (x[i] != y[i]) return i;
+  }
+  return n;
+}
+#if defined(__SSE2__)
+inline size_t mismatch_bytes_sse2(const unsigned char* x, 
+                                  const unsigned char* y, size_t n) {
+  if (n < 16) return mismatch_bytes_scalar(x, y, n);
+  for (size_t i = 0;; i += 16) {
+    if (i + 16 > n) i = n - 16;
+    __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(x + i));
+    __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(y + i));
+    unsigned mask = _mm_movemask_epi8(_mm_cmpeq_epi8(a, b)) ^ 0xffffu;
+    if (mask != 0) return i + __builtin_ctz(mask);
+    if (i + 16 == n) return n;
+  }
+}
+__attribute__((target("avx2")))
+inline size_t mismatch_bytes_avx2(const unsigned char* x, 
+                                  const unsigned char* y, size_t n) {
+  if (n < 32) return mismatch_bytes_sse2(x, y, n);
+  for (size_t i = 0;; i += 32) {
+    if (i + 32 > n) i = n - 32;
+    __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + i));
+    __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(y + i));
+    unsigned mask = ~unsigned(_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)));
+    if (mask != 0) return i + __builtin_ctz(mask);
+    if (i + 32 == n) return n;
+  }
+}
+typedef size_t (*mismatch_kernel)(const unsigned char*, const unsigned char*,
+                                  size_t);
+inline mismatch_kernel select_mismatch_kernel() {
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2") ? &mismatch_bytes_avx2 
+                                        : &mismatch_bytes_sse2;
+}
+inline size_t mismatch_bytes(const void* x, const void* y, size_t n) {
+  const unsigned char* a = static_cast<const unsigned char*>(x);
+  const unsigned char* b = static_cast<const unsigned char*>(y);
+  if (n <= 64) return mismatch_bytes_sse2(a, b, n);
+  static const mismatch_kernel kernel = select_mismatch_kernel();
+  return kernel(a, b, n);
+}
+#else
+inline size_t mismatch_bytes(const void* x, const void* y, size_t n) {
+  return mismatch_bytes_scalar(static_cast<const unsigned char*>(x),
+                               static_cast<const unsigned char*>(y), n);
+}
+#endif
 
 /* Note: Simple Version */
 template <typename InputIterator, typename OutputIterator>
@@ -96,6 +326,27 @@ inline OutputIterator copy(InputIterator first, InputIterator last,
   }
   return result;
 }
+template <typename Tp>
+inline Tp* copy_aux(const Tp* first, const Tp* last, Tp* result, true_type) {
+  return copy_trivial(first, last, result);
+}
+template <typename Tp>
+inline Tp* copy_aux(const Tp* first, const Tp* last, Tp* result, false_type) {
+  for (; first != last; ++first, ++result) {
+    *result = *first;
+  }
+  return result;
+}
+template <typename Tp>
+inline Tp* copy(const Tp* first, const Tp* last, Tp* result) {
+  return copy_aux(first, last, result, 
+    typename is_trivially_copyable<Tp>::type());
+}
+template <typename Tp>
+inline Tp* copy(Tp* first, Tp* last, Tp* result) {
+  return copy_aux<Tp>(first, last, result, 
+    typename is_trivially_copyable<Tp>::type());
+}
 /* Note: Simple Version */
 template <typename BidirectionalIterator_1, typename BidirectionalIterator_2>
 inline BidirectionalIterator_2 copy_backward(
@@ -106,6 +357,81 @@ inline BidirectionalIterator_2 copy_backward(
   }
   return result;
 }
+template <typename Tp>
+inline Tp* copy_backward_aux(const Tp* first, const Tp* last, Tp* result, 
+                             true_type) {
+  return copy_backward_trivial(first, last, result);
+}
+template <typename Tp>
+inline Tp* copy_backward_aux(const Tp* first, const Tp* last, Tp* result, 
+                             false_type) {
+  while (first != last) {
+    *(--result) = *(--last);
+  }
+  return result;
+}
+template <typename Tp>
+inline Tp* copy_backward(const Tp* first, const Tp* last, Tp* result) {
+  return copy_backward_aux(first, last, result, 
+    typename is_trivially_copyable<Tp>::type());
+}
+template <typename Tp>
+inline Tp* copy_backward(Tp* first, Tp* last, Tp* result) {
+  return copy_backward_aux<Tp>(first, last, result, 
+    typename is_trivially_copyable<Tp>::type());
+}
+
+/* Note: Simple Version */
+template <typename InputIterator, typename OutputIterator>
+inline OutputIterator move(InputIterator first, InputIterator last,
+                           OutputIterator result) {
+  for (; first != last; ++first, ++result) {
+    *result = mystl::move(*first);
+  }
+  return result;
+}
+template <typename Tp>
+inline Tp* move_aux(Tp* first, Tp* last, Tp* result, true_type) {
+  return copy_trivial<Tp>(first, last, result);
+}
+template <typename Tp>
+inline Tp* move_aux(Tp* first, Tp* last, Tp* result, false_type) {
+  for (; first != last; ++first, ++result) {
+    *result = mystl::move(*first);
+  }
+  return result;
+}
+template <typename Tp>
+inline Tp* move(Tp* first, Tp* last, Tp* result) {
+  return move_aux(first, last, result, 
+    typename is_trivially_copyable<Tp>::type());
+}
+/* Note: Simple Version */
+template <typename BidirectionalIterator_1, typename BidirectionalIterator_2>
+inline BidirectionalIterator_2 move_backward(
+  BidirectionalIterator_1 first, BidirectionalIterator_1 last,
+  BidirectionalIterator_2 result) {
+  while (first != last) {
+    *(--result) = mystl::move(*(--last));
+  }
+  return result;
+}
+template <typename Tp>
+inline Tp* move_backward_aux(Tp* first, Tp* last, Tp* result, true_type) {
+  return copy_backward_trivial<Tp>(first, last, result);
+}
+template <typename Tp>
+inline Tp* move_backward_aux(Tp* first, Tp* last, Tp* result, false_type) {
+  while (first != last) {
+    *(--result) = mystl::move(*(--last));
+  }
+  return result;
+}
+template <typename Tp>
+inline Tp* move_backward(Tp* first, Tp* last, Tp* result) {
+  return move_backward_aux(first, last, result, 
+    typename is_trivially_copyable<Tp>::type());
+}
 
 /* Note: Simple Version */
 template <typename ForwardIterator, typename Tp>
@@ -114,6 +440,20 @@ void fill(ForwardIterator first, ForwardIterator last, const Tp& value) {
     *first = value;
   }
 }
+template <typename Tp>
+inline void fill_aux(Tp* first, Tp* last, const Tp& value, true_type) {
+  fill_trivial(first, last - first, value);
+}
+template <typename Tp>
+inline void fill_aux(Tp* first, Tp* last, const Tp& value, false_type) {
+  for (; first != last; ++first) {
+    *first = value;
+  }
+}
+template <typename Tp>
+inline void fill(Tp* first, Tp* last, const Tp& value) {
+  fill_aux(first, last, value, typename is_trivially_copyable<Tp>::type());
+}
 /* Note: Simple Version */
 template <typename OutputIterator, typename Size, typename Tp>
 OutputIterator fill_n(OutputIterator first, Size n, const Tp& value) {
@@ -122,70 +462,144 @@ OutputIterator fill_n(OutputIterator first, Size n, const Tp& value) {
   }
   return first;
 }
+template <typename Tp, typename Size>
+inline Tp* fill_n_aux(Tp* first, Size n, const Tp& value, true_type) {
+  return n > 0 ? fill_trivial(first, n, value) : first;
+}
+template <typename Tp, typename Size>
+inline Tp* fill_n_aux(Tp* first, Size n, const Tp& value, false_type) {
+  for (; n > 0; --n, ++first) {
+    *first = value;
+  }
+  return first;
+}
+template <typename Tp, typename Size>
+inline Tp* fill_n(Tp* first, Size n, const Tp& value) {
+  return fill_n_aux(first, n, value, 
+    typename is_trivially_copyable<Tp>::type());
+}
 
 /* Note: Simple Version */
 template <typename InputIterator, typename ForwardIterator>
 ForwardIterator uninitialized_copy(InputIterator first, InputIterator last,
                                    ForwardIterator result) {
-  int i = 0;
-  for (i = 0; first != last; ++first, ++i) {
-    new(result + i) typename 
-      iterator_traits<InputIterator>::value_type(*first);
+  for (; first != last; ++first, ++result) {
+    new(&*result) typename 
+      iterator_traits<ForwardIterator>::value_type(*first);
+  }
+  return result;
+}
+template <typename Tp>
+inline Tp* uninitialized_copy_aux(const Tp* first, const Tp* last, 
+                                  Tp* result, true_type) {
+  return copy_trivial(first, last, result);
+}
+template <typename Tp>
+inline Tp* uninitialized_copy_aux(const Tp* first, const Tp* last, 
+                                  Tp* result, false_type) {
+  for (; first != last; ++first, ++result) {
+    new(result) Tp(*first);
+  }
+  return result;
+}
+template <typename Tp>
+inline Tp* uninitialized_copy(const Tp* first, const Tp* last, Tp* result) {
+  return uninitialized_copy_aux(first, last, result, 
+    typename is_trivially_copyable<Tp>::type());
+}
+template <typename Tp>
+inline Tp* uninitialized_copy(Tp* first, Tp* last, Tp* result) {
+  return uninitialized_copy_aux<Tp>(first, last, result, 
+    typename is_trivially_copyable<Tp>::type());
+}
+/* Note: Simple Version */
+template <typename InputIterator, typename ForwardIterator>
+ForwardIterator uninitialized_move(InputIterator first, InputIterator last,
+                                   ForwardIterator result) {
+  for (; first != last; ++first, ++result) {
+    new(&*result) typename 
+      iterator_traits<ForwardIterator>::value_type(mystl::move(*first));
   }
-  return result + i;
+  return result;
+}
+template <typename Tp>
+inline Tp* uninitialized_move_aux(Tp* first, Tp* last, Tp* result, 
+                                  true_type) {
+  return copy_trivial<Tp>(first, last, result);
+}
+template <typename Tp>
+inline Tp* uninitialized_move_aux(Tp* first, Tp* last, Tp* result, 
+                                  false_type) {
+  for (; first != last; ++first, ++result) {
+    new(result) Tp(mystl::move(*first));
+  }
+  return result;
+}
+template <typename Tp>
+inline Tp* uninitialized_move(Tp* first, Tp* last, Tp* result) {
+  return uninitialized_move_aux(first, last, result, 
+    typename is_trivially_copyable<Tp>::type());
+}
+/* Moves, or copies if moving may throw and Tp is copyable. */
+template <typename Tp>
+inline Tp* uninitialized_move_if_noexcept_aux(Tp* first, Tp* last, 
+                                              Tp* result, true_type) {
+  return copy_trivial<Tp>(first, last, result);
+}
+template <typename Tp>
+inline Tp* uninitialized_move_if_noexcept_aux(Tp* first, Tp* last, 
+                                              Tp* result, false_type) {
+  for (; first != last; ++first, ++result) {
+    new(result) Tp(mystl::move_if_noexcept(*first));
+  }
+  return result;
+}
+template <typename Tp>
+inline Tp* uninitialized_move_if_noexcept(Tp* first, Tp* last, Tp* result) {
+  return uninitialized_move_if_noexcept_aux(first, last, result, 
+    typename is_trivially_copyable<Tp>::type());
 }
 /* Note: Simple Version */
 template <typename ForwardIterator, typename Tp>
 void uninitialized_fill(ForwardIterator first, ForwardIterator last, 
                         const Tp& value) {
   for (; first != last; ++first) {
-    new(first) typename iterator_traits<ForwardIterator>::value_type(value);
+    new(&*first) typename 
+      iterator_traits<ForwardIterator>::value_type(value);
   }
 }
 /* Note: Simple Version */
 template <typename ForwardIterator, typename Size, typename Tp>
 ForwardIterator uninitialized_fill_n(ForwardIterator first, Size n, 
                                      const Tp& value) {
-  int i = 0;
-  for (i = 0; i != n; ++i) {
-    new((Tp*)(first + i)) typename 
+  for (; n > 0; --n, ++first) {
+    new(&*first) typename 
       iterator_traits<ForwardIterator>::value_type(value);
   }
-  return first + i;
+  return first;
+}
+template <typename Tp, typename Size>
+inline Tp* uninitialized_fill_n_aux(Tp* first, Size n, const Tp& value, 
+                                    true_type) {
+  return n > 0 ? fill_trivial(first, n, value) : first;
+}
+template <typename Tp, typename Size>
+inline Tp* uninitialized_fill_n_aux(Tp* first, Size n, const Tp& value, 
+                                    false_type) {
+  for (; n > 0; --n, ++first) {
+    new(first) Tp(value);
+  }
+  return first;
+}
+template <typename Tp, typename Size>
+inline Tp* uninitialized_fill_n(Tp* first, Size n, const Tp& value) {
+  return uninitialized_fill_n_aux(first, n, value, 
+    typename is_trivially_copyable<Tp>::type());
+}
+template <typename Tp>
+inline void uninitialized_fill(Tp* first, Tp* last, const Tp& value) {
+  uninitialized_fill_n(first, last - first, value);
 }
-
-
-/* Note: Variant */
-struct true_type {};
-struct false_type {};
-template <typename Tp> struct is_integral { 
-  typedef false_type type; static const bool value = false; };
-template <> struct is_integral<bool> {
-  typedef true_type type;  static const bool value = true; };
-template <> struct is_integral<char> {
-  typedef true_type type;  static const bool value = true; };
-template <> struct is_integral<signed char> {
-  typedef true_type type; static const bool value = true; };
-template <> struct is_integral<unsigned char> {
-  typedef true_type type;  static const bool value = true; };
-template <> struct is_integral<wchar_t> {
-  typedef true_type type;  static const bool value = true; };
-template <> struct is_integral<short> {
-  typedef true_type type; static const bool value = true; };
-template <> struct is_integral<unsigned short> {
-  typedef true_type type;  static const bool value = true; };
-template <> struct is_integral<int> {
-  typedef true_type type;  static const bool value = true; };
-template <> struct is_integral<unsigned int> {
-  typedef true_type type;  static const bool value = true; };
-template <> struct is_integral<long> {
-  typedef true_type type;  static const bool value = true; };
-template <> struct is_integral<unsigned long> {
-  typedef true_type type;  static const bool value = true; };
-template <> struct is_integral<long long> {
-  typedef true_type type;  static const bool value = true; };
-template <> struct is_integral<unsigned long long> { 
-  typedef true_type type;  static const bool value = true; };
 
 template <typename Tp>
 class new_allocator {
@@ -197,6 +611,7 @@ public:
   typedef const Tp* const_pointer;
   typedef Tp& reference;
   typedef const Tp& const_reference;
+  typedef true_type propagate_on_container_move_assignment;
   
   template <typename Tp1>
   struct rebind { typedef new_allocator<Tp1> other; };
@@ -218,8 +633,9 @@ public:
   }
   void deallocate(pointer p, size_type) { ::operator delete(p); }
 
-  void construct(pointer p, const Tp& value) { 
-    ::new((void*)p) Tp(value); 
+  template <typename Up, typename... Args>
+  void construct(Up* p, Args&&... args) { 
+    ::new((void*)p) Up(mystl::forward<Args>(args)...); 
   }
   void destroy(pointer p) { p->~Tp(); }
 };
@@ -235,7 +651,171 @@ inline bool operator!=(const new_allocator<Tp1>& x,
 }
 
 
-template <typename Tp, typename Allocator = new_allocator<Tp>>
+/* Note: Simple Version
+ * allocator_traits only covers the propagation traits. Each of them is 
+ * false_type unless the allocator declares it, as in the standard.
+ */
+template <typename Tp> struct void_type { typedef void type; };
+// An lvalue of type Tp, for use in decltype only; never defined.
+template <typename Tp> Tp& declval_ref() noexcept;
+template <typename Allocator, typename = void>
+struct allocator_pocca { typedef false_type type; };
+template <typename Allocator>
+struct allocator_pocca<Allocator, typename void_type<
+  typename Allocator::propagate_on_container_copy_assignment>::type> {
+  typedef typename Allocator::propagate_on_container_copy_assignment type;
+};
+template <typename Allocator, typename = void>
+struct allocator_pocma { typedef false_type type; };
+template <typename Allocator>
+struct allocator_pocma<Allocator, typename void_type<
+  typename Allocator::propagate_on_container_move_assignment>::type> {
+  typedef typename Allocator::propagate_on_container_move_assignment type;
+};
+template <typename Allocator, typename = void>
+struct allocator_pocs { typedef false_type type; };
+template <typename Allocator>
+struct allocator_pocs<Allocator, typename void_type<
+  typename Allocator::propagate_on_container_swap>::type> {
+  typedef typename Allocator::propagate_on_container_swap type;
+};
+/* An allocator may offer
+ *   pointer reallocate(pointer p, size_type old_n, size_type new_n,
+ *                      size_type used)
+ * which resizes the buffer at p (or allocates one if p is null), keeping
+ * the bytes of its first used elements, e.g. with mremap. vector then
+ * uses it instead of allocate, relocate and deallocate whenever Tp is
+ * trivially relocatable.
+ *
+ * It may also offer
+ *   bool expand_in_place(pointer p, size_type old_n, size_type new_n)
+ * which grows the buffer at p without moving it, or returns false. Since
+ * no element moves, vector tries it before any other kind of growth for 
+ * element types that cannot be reallocated.
+ */
+template <typename Allocator, typename = void>
+struct allocator_has_reallocate { typedef false_type type; };
+template <typename Allocator>
+struct allocator_has_reallocate<Allocator, typename void_type<decltype(
+  declval_ref<Allocator>().reallocate(typename Allocator::pointer(),
+                                      size_t(), size_t(), size_t()))>::type> {
+  typedef true_type type;
+};
+template <typename Allocator, typename = void>
+struct allocator_has_expand_in_place { typedef false_type type; };
+template <typename Allocator>
+struct allocator_has_expand_in_place<Allocator, typename void_type<decltype(
+  declval_ref<Allocator>().expand_in_place(typename Allocator::pointer(),
+                                           size_t(), size_t()))>::type> {
+  typedef true_type type;
+};
+template <typename Allocator>
+struct allocator_traits {
+  typedef typename allocator_pocca<Allocator>::type 
+          propagate_on_container_copy_assignment;
+  typedef typename allocator_pocma<Allocator>::type 
+          propagate_on_container_move_assignment;
+  typedef typename allocator_pocs<Allocator>::type 
+          propagate_on_container_swap;
+  typedef typename allocator_has_reallocate<Allocator>::type has_reallocate;
+  typedef typename allocator_has_expand_in_place<Allocator>::type 
+          has_expand_in_place;
+};
+
+/* Growth policies
+ * When vector runs out of capacity it asks its GrowthPolicy for the new
+ * capacity, given the current size, the number of elements about to be
+ * inserted and the element size. The result must be at least 
+ * old_size + n.
+ *
+ * After erase(), pop_back() and clear() vector asks trim_capacity() how 
+ * much capacity to keep; anything less than the current capacity makes it
+ * shrink. The policies below never trim unless wrapped in trimming_growth.
+ */
+struct growth_policy_base {
+  static size_t trim_capacity(size_t size, size_t capacity) { 
+    return capacity; 
+  }
+};
+struct double_growth : growth_policy_base {
+  static size_t next_capacity(size_t old_size, size_t n, size_t elem_size) {
+    return old_size >= n ? 2 * old_size : old_size + n;
+  }
+};
+/* Grows by 1.5x. The sum of the freed buffers eventually exceeds the next
+ * request, so an allocator can reuse that memory for later growth.
+ */
+struct one_and_half_growth : growth_policy_base {
+  static size_t next_capacity(size_t old_size, size_t n, size_t elem_size) {
+    size_t grown = old_size + old_size / 2;
+    return grown >= old_size + n ? grown : old_size + n;
+  }
+};
+/* Rounds the buffer size of GrowthPolicy up to the next allocator size 
+ * class, so that the slack bytes the allocator hands out anyway become 
+ * usable capacity. The classes follow jemalloc: multiples of 16 bytes up 
+ * to 128 bytes, then four evenly spaced classes per power of two.
+ */
+template <typename GrowthPolicy = double_growth>
+struct size_class_growth : GrowthPolicy {
+  static size_t round_bytes(size_t bytes) {
+    if (bytes <= 16) return 16;
+    int msb = 63 - __builtin_clzl(bytes - 1);  // 2^msb < bytes <= 2^(msb+1)
+    size_t step = msb > 5 ? size_t(1) << (msb - 2) : 16;
+    return (bytes + step - 1) & ~(step - 1);
+  }
+  static size_t next_capacity(size_t old_size, size_t n, size_t elem_size) {
+    size_t capacity = GrowthPolicy::next_capacity(old_size, n, elem_size);
+    return round_bytes(capacity * elem_size) / elem_size;
+  }
+};
+/* Rounds buffers of at least Threshold bytes up to a multiple of the 2 MiB
+ * huge page size, so that large vectors can be backed by transparent huge
+ * pages without a partially used page at the end.
+ */
+template <typename GrowthPolicy = double_growth, 
+          size_t Threshold = (size_t(1) << 21)>
+struct huge_page_growth : GrowthPolicy {
+  static const size_t huge_page_size = size_t(1) << 21;
+  static size_t next_capacity(size_t old_size, size_t n, size_t elem_size) {
+    size_t capacity = GrowthPolicy::next_capacity(old_size, n, elem_size);
+    size_t bytes = capacity * elem_size;
+    if (bytes < Threshold) return capacity;
+    bytes = (bytes + huge_page_size - 1) & ~(huge_page_size - 1);
+    return bytes / elem_size;
+  }
+};
+/* Releases memory once size() drops below Num / Den of capacity(), 
+ * keeping twice the remaining size. The gap between the trim threshold
+ * and the new capacity keeps a vector that oscillates around a size from
+ * reallocating on every push_back() / pop_back().
+ */
+template <typename GrowthPolicy = double_growth, size_t Num = 1, 
+          size_t Den = 4>
+struct trimming_growth : GrowthPolicy {
+  static size_t trim_capacity(size_t size, size_t capacity) {
+    return size * Den < capacity * Num ? 2 * size : capacity;
+  }
+};
+
+/* Allocation statistics
+ * vector reports its buffer traffic to vector_stats<Tp>. Unless 
+ * MYSTL_VECTOR_STATS is defined, which pulls in the counting version from 
+ * vector_stats.h, the hooks are empty and compile away.
+ */
+#ifndef MYSTL_VECTOR_STATS
+template <typename Tp>
+struct vector_stats {
+  static void on_allocate(size_t n) {}
+  static void on_relocate(size_t n) {}
+  static void on_copy(size_t n) {}
+  static void on_reallocate(size_t old_capacity, size_t new_capacity) {}
+  static void on_deallocate(size_t capacity, size_t size) {}
+};
+#endif
+
+template <typename Tp, typename Allocator = new_allocator<Tp>, 
+          typename GrowthPolicy = double_growth>
 class vector {
 public:
   typedef size_t size_type;
@@ -250,43 +830,58 @@ public:
   typedef mystl::reverse_iterator<iterator> reverse_iterator;  
   typedef mystl::reverse_iterator<const_iterator> const_reverse_iterator;
   typedef Allocator allocator_type;
+  typedef GrowthPolicy growth_policy;
 
   vector() : 
     start_(0), finish_(0), end_of_storage_(0), allocator_(Allocator()) {}
   explicit vector(const Allocator& alloc) : 
     start_(0), finish_(0), end_of_storage_(0), allocator_(alloc) {}
   vector(size_type n, const Allocator& alloc = Allocator()) :
-    start_(allocator_.allocate(n)), 
-    finish_(uninitialized_fill_n(start_, n, Tp())), 
-    end_of_storage_(start_ + n), allocator_(alloc) {}
+    start_(0), finish_(0), end_of_storage_(0), allocator_(alloc) {
+    fill_initialize(n, Tp());
+  }
   vector(size_type n, const Tp& value, const Allocator& alloc = Allocator()) :
-    start_(allocator_.allocate(n)), 
-    finish_(uninitialized_fill_n(start_, n, value)), 
-    end_of_storage_(start_ + n), allocator_(alloc) {}
+    start_(0), finish_(0), end_of_storage_(0), allocator_(alloc) {
+    fill_initialize(n, value);
+  }
   template <typename InputIterator>
   vector(InputIterator first, InputIterator last, 
          const Allocator& alloc = Allocator()) :
     start_(0), finish_(0), end_of_storage_(0), allocator_(alloc) {
-    initialize_aux(first, last, alloc, 
-      typename is_integral<InputIterator>::type());
+    initialize_aux(first, last, typename is_integral<InputIterator>::type());
   }
   vector(const vector& other) : 
-    start_(allocator_.allocate(other.size())), 
-    finish_(uninitialized_copy(other.begin(), other.end(), start_)), 
-    end_of_storage_(start_ + other.size()), allocator_(Allocator()) {}
+    start_(0), finish_(0), end_of_storage_(0), allocator_(other.allocator_) {
+    range_initialize(other.begin(), other.end(), forward_iterator_tag());
+  }
   vector(const vector& other, const Allocator& alloc) : 
-    start_(allocator_.allocate(other.size())), 
-    finish_(uninitialized_copy(other.begin(), other.end(), start_)), 
-    end_of_storage_(start_ + other.size()), allocator_(alloc) {}
-  vector(vector&& other) : 
-    start_(move(other.start_)), finish_(move(other.finish_)),
-    end_of_storage_(move(end_of_storage_)), allocator_(move(other.alloc)) {}
+    start_(0), finish_(0), end_of_storage_(0), allocator_(alloc) {
+    range_initialize(other.begin(), other.end(), forward_iterator_tag());
+  }
+  vector(vector&& other) noexcept : 
+    start_(other.start_), finish_(other.finish_),
+    end_of_storage_(other.end_of_storage_), 
+    allocator_(mystl::move(other.allocator_)) {
+    other.start_ = other.finish_ = other.end_of_storage_ = 0;
+  }
   vector(vector&& other, const Allocator& alloc) : 
-    start_(move(other.start_)), finish_(move(other.finish_)),
-    end_of_storage_(move(end_of_storage_)), allocator_(alloc) {}
+    start_(0), finish_(0), end_of_storage_(0), allocator_(alloc) {
+    if (allocator_ == other.allocator_) {
+      steal(other);
+    } else {
+      move_from(other);
+    }
+  }
 
   vector& operator=(const vector& other) {
     if (&other != this) {
+      copy_assign_allocator(other.allocator_, typename allocator_traits<
+        Allocator>::propagate_on_container_copy_assignment());
+      if (other.size() > capacity() && can_reallocate::value) {
+        destroy(start_, finish_);
+        finish_ = start_;
+        reallocate(other.size());
+      }
       if (other.size() > capacity()) {
         iterator new_start = allocate_and_copy(
           other.size(), other.begin(), other.end());
@@ -294,21 +889,22 @@ public:
         start_ = new_start;
         end_of_storage_ = start_ + other.size();
       } else if (other.size() > size()) {
-        copy(other.begin(), other.begin() + size(), begin());
-        uninitialized_copy(other.begin() + size(), other.end(), finish_);
+        mystl::copy(other.begin(), other.begin() + size(), begin());
+        mystl::uninitialized_copy(other.begin() + size(), other.end(), finish_);
       } else {
-        iterator new_finish = copy(other.begin(), other.end(), start_);
+        iterator new_finish = mystl::copy(other.begin(), other.end(), start_);
         destroy(new_finish, finish_);
       }
       finish_ = start_ + other.size();
     }
     return *this;
   }
-  vector& operator=(vector&& other) {
-    start_ = move(other.start_);
-    finish_ = move(other.finish_);
-    end_of_storage_ = move(other.end_of_storage_);
-    allocator_ = move(other.allocator_);
+  vector& operator=(vector&& other) noexcept(allocator_traits<
+    Allocator>::propagate_on_container_move_assignment::value) {
+    if (&other != this) {
+      move_assign(other, typename allocator_traits<
+        Allocator>::propagate_on_container_move_assignment());
+    }
     return *this;
   }
 
@@ -359,17 +955,17 @@ public:
   size_type capacity() const { return size_type(end_of_storage_ - start_); }
 
   void reserve(size_type n) {
-    if (capacity() < n) {
-      size_type old_size = size();
-      iterator new_start = allocate_and_copy(n, start_, finish_);
-      destroy_and_deallocate();
-      start_ = new_start;
-      finish_ = new_start + old_size;
-      end_of_storage_ = start_ + n;
-    }
+    if (capacity() < n) reallocate(n);
   }
-  void shrink_to_fit() {
-    end_of_storage_ = finish_;
+  void shrink_to_fit() { shrink_to(size()); }
+  void shrink_to(size_type n) {
+    if (n < size()) n = size();
+    if (n >= capacity()) return;
+    if (n == 0) {
+      replace_storage(0, 0, 0);
+    } else {
+      reallocate(n);
+    }
   }
 
   void clear() { erase(begin(), end()); }
@@ -379,28 +975,24 @@ public:
       allocator_.construct(finish_, value);
       ++finish_;
     } else {
-      insert_aux(pos, value);
+      emplace_aux(pos, value);
     }
     return begin() + n;
   }
   iterator insert(iterator pos, Tp&& value) {
     size_type n = pos - begin();
     if (finish_ != end_of_storage_ && pos == end()) {
-      allocator_.construct(finish_, move(value));
+      allocator_.construct(finish_, mystl::move(value));
       ++finish_;
     } else {
-      insert_aux(pos, move(value));
+      emplace_aux(pos, mystl::move(value));
     }
     return begin() + n;
   }
   iterator insert(iterator pos, size_type n, const Tp& value) {
-    if (finish_ + n - 1 != end_of_storage_ && pos == end()) {
-      uninitialized_fill_n(finish_, n, value);
-      finish_ += n;
-    } else {
-      insert_aux(pos, n, value);
-    }
-    return begin() + n;
+    size_type offset = pos - begin();
+    insert_aux(pos, n, value);
+    return begin() + offset;
   }
   template <typename InputIterator>
   iterator insert(iterator pos, InputIterator first, 
@@ -409,39 +1001,117 @@ public:
       typename is_integral<InputIterator>::type());
   }
   iterator erase(iterator pos) {
+    if (is_trivially_relocatable<Tp>::value) {
+      allocator_.destroy(pos);
+      close_gap(pos, 1);
+      return auto_trim(pos);
+    }
     if (pos + 1 != end()) {
-      copy(pos + 1, finish_, pos);
+      mystl::move(pos + 1, finish_, pos);
     }
     --finish_;
     allocator_.destroy(finish_);
-    return pos;
+    return auto_trim(pos);
   }
   iterator erase(iterator first, iterator last) {
-    iterator new_finish = copy(last, finish_, first);
+    // An empty range must not move the tail onto itself.
+    if (first == last) return first;
+    if (is_trivially_relocatable<Tp>::value) {
+      destroy(first, last);
+      close_gap(first, last - first);
+      return auto_trim(first);
+    }
+    iterator new_finish = mystl::move(last, finish_, first);
+    destroy(new_finish, finish_);
     finish_ = new_finish;
-    return first;
+    return auto_trim(first);
+  }
+  /* Batch and unordered erasure
+   * erase_if() removes every element for which pred returns true, and
+   * erase_indices() the elements at an ascending list of positions, in
+   * one pass that moves each surviving element at most once. Both return
+   * the number of elements removed. If pred throws, the elements already
+   * tested are removed or kept as decided and the rest are kept.
+   *
+   * erase_unordered() removes one element in O(1) by moving the last
+   * element into its place.
+   */
+  template <typename Predicate>
+  size_type erase_if(Predicate pred) {
+    return remove_from(begin(), pred);
+  }
+  // Repeated indices are removed once.
+  template <typename InputIterator>
+  size_type erase_indices(InputIterator first, InputIterator last) {
+    if (first == last) return 0;
+    index_predicate<InputIterator> pred = {start_, first, last};
+    return remove_from(start_ + *first, pred);
+  }
+  iterator erase_unordered(iterator pos) {
+    iterator back = finish_ - 1;
+    if (pos != back && is_trivially_relocatable<Tp>::value) {
+      allocator_.destroy(pos);
+      __builtin_memcpy(static_cast<void*>(pos),
+                       static_cast<const void*>(back), sizeof(Tp));
+      --finish_;
+      return auto_trim(pos);
+    }
+    if (pos != back) *pos = mystl::move(*back);
+    --finish_;
+    allocator_.destroy(finish_);
+    return auto_trim(pos);
   }
   void push_back(const Tp& value) {
     if (finish_ != end_of_storage_) {
       allocator_.construct(finish_, value);
       ++finish_;
     } else {
-      insert_aux(end(), value);
+      emplace_aux(end(), value);
     }
   }
   void push_back(Tp&& value) {
     if (finish_ != end_of_storage_) {
-      allocator_.construct(finish_, move(value));
+      allocator_.construct(finish_, mystl::move(value));
+      ++finish_;
+    } else {
+      emplace_aux(end(), mystl::move(value));
+    }
+  }
+  template <typename... Args>
+  iterator emplace(iterator pos, Args&&... args) {
+    size_type n = pos - begin();
+    if (finish_ != end_of_storage_ && pos == end()) {
+      allocator_.construct(finish_, mystl::forward<Args>(args)...);
+      ++finish_;
+    } else {
+      emplace_aux(pos, mystl::forward<Args>(args)...);
+    }
+    return begin() + n;
+  }
+  template <typename... Args>
+  void emplace_back(Args&&... args) {
+    if (finish_ != end_of_storage_) {
+      allocator_.construct(finish_, mystl::forward<Args>(args)...);
       ++finish_;
     } else {
-      insert_aux(end(), move(value));
+      emplace_aux(end(), mystl::forward<Args>(args)...);
     }
   }
   void pop_back() {
     --finish_;
     allocator_.destroy(finish_);
+    auto_trim(finish_);
+  }
+  void resize(size_type n) {
+    if (n < size()) {
+      erase(begin() + n, end());
+    } else {
+      reserve_for_append(n - size());
+      for (; size() < n; ++finish_) {
+        allocator_.construct(finish_);
+      }
+    }
   }
-  void resize(size_type n) { resize(n, Tp()); }
   void resize(size_type n, const Tp& value) {
     if (n < size()) {
       erase(begin() + n, end());
@@ -449,28 +1119,68 @@ public:
       insert(end(), n - size(), value);
     }
   }
+  /* Bulk append
+   * resize_default_init() and append_uninitialized() default-initialize
+   * the new elements, which leaves trivial types such as char or int 
+   * uninitialized, so that a reader can fill them without writing every
+   * element twice:
+   *
+   *   char* p = buffer.append_uninitialized(n);
+   *   buffer.resize(buffer.size() - n + read(fd, p, n));
+   *
+   * Like append(), they reallocate at most once.
+   */
+  void resize_default_init(size_type n) {
+    if (n < size()) {
+      erase(begin() + n, end());
+    } else {
+      append_uninitialized(n - size());
+    }
+  }
+  // Appends n default-initialized elements and returns the first of them.
+  pointer append_uninitialized(size_type n) {
+    reserve_for_append(n);
+    iterator first = finish_;
+    for (; n > 0; --n, ++finish_) {
+      ::new(static_cast<void*>(finish_)) Tp;
+    }
+    return first;
+  }
+  // Appends a copy of [p, p + n), which may lie inside the vector.
+  void append(const Tp* p, size_type n) {
+    static_assert(is_trivially_copyable<Tp>::value, 
+                  "append() requires a trivially copyable element type");
+    if (size_type(end_of_storage_ - finish_) < n) {
+      bool inside = p >= start_ && p < finish_;
+      size_type offset = p - start_;
+      reallocate(next_capacity(n));
+      if (inside) p = start_ + offset;
+    }
+    finish_ = mystl::copy_trivial(p, p + n, finish_);
+  }
   void swap(vector& other) {
-    using mystl::swap;
-    swap(start_, other.start_);
-    swap(finish_, other.finish_);
-    swap(end_of_storage_, other.end_of_storage_);
+    mystl::swap(start_, other.start_);
+    mystl::swap(finish_, other.finish_);
+    mystl::swap(end_of_storage_, other.end_of_storage_);
+    swap_allocator(other, typename allocator_traits<
+      Allocator>::propagate_on_container_swap());
   }
 
 protected:
   template <typename Integral>
-  void initialize_aux(Integral n, Integral value, const Allocator& alloc, 
-                      true_type) {
-    start_ = allocator_.allocate(n);
-    finish_ = uninitialized_fill_n(start_, n, value);
-    end_of_storage_ = start_ + n;
-    allocator_ = alloc;
+  void initialize_aux(Integral n, Integral value, true_type) {
+    fill_initialize(size_type(n), Tp(value));
   }
   template <typename InputIterator>
-  void initialize_aux(InputIterator first, InputIterator last, 
-                      const Allocator& alloc, false_type) {
-    range_initialize(first, last, alloc,
+  void initialize_aux(InputIterator first, InputIterator last, false_type) {
+    range_initialize(first, last, 
       typename iterator_traits<InputIterator>::iterator_category());
   }  
+  void fill_initialize(size_type n, const Tp& value) {
+    start_ = allocate(n);
+    finish_ = mystl::uninitialized_fill_n(start_, n, value);
+    end_of_storage_ = start_ + n;
+  }
   template <typename InputIterator>
   void range_initialize(InputIterator first, InputIterator last, 
                         input_iterator_tag) {
@@ -480,36 +1190,293 @@ protected:
   }
   template <typename ForwardIterator>
   void range_initialize(ForwardIterator first, ForwardIterator last,
-                        const Allocator& alloc, forward_iterator_tag) {
-    size_type n = distance(first, last);
-    start_ = allocator_.allocate(n);
-    finish_ = uninitialized_copy(first, last, start_);
+                        forward_iterator_tag) {
+    size_type n = mystl::distance(first, last);
+    start_ = allocate(n);
+    finish_ = mystl::uninitialized_copy(first, last, start_);
     end_of_storage_ = start_ + n;
-    allocator_ = alloc;
+  }
+  iterator allocate(size_type n) {
+    vector_stats<Tp>::on_allocate(n);
+    return allocator_.allocate(n);
   }
   iterator allocate_and_copy(size_type n, const_iterator first, 
                              const_iterator last) {
-    iterator result = allocator_.allocate(n);
-    uninitialized_copy(first, last, result);
+    iterator result = allocate(n);
+    vector_stats<Tp>::on_copy(last - first);
+    mystl::uninitialized_copy(first, last, result);
+    return result;
+  }
+  iterator allocate_and_move(size_type n, iterator first, iterator last) {
+    iterator result = allocate(n);
+    relocate(first, last, result);
     return result;
   }
+  /* Moves [first, last) into raw storage at result, falling back to copies
+   * if Tp's move constructor may throw. The caller then disposes of the 
+   * source with destroy_relocated(). Trivially relocatable elements are 
+   * copied as bytes and their sources need no destructor call.
+   */
+  iterator relocate(iterator first, iterator last, iterator result) {
+    vector_stats<Tp>::on_relocate(last - first);
+    return relocate_aux(first, last, result, 
+                        typename is_trivially_relocatable<Tp>::type());
+  }
+  iterator relocate_aux(iterator first, iterator last, iterator result,
+                        true_type) {
+    if (first == last) return result;
+    // Counting bytes between the pointers keeps the size within the
+    // source range as far as the compiler can tell.
+    const char* from = reinterpret_cast<const char*>(first);
+    const char* to = reinterpret_cast<const char*>(last);
+    __builtin_memcpy(static_cast<void*>(result),
+                     static_cast<const void*>(from), size_t(to - from));
+    return result + (last - first);
+  }
+  iterator relocate_aux(iterator first, iterator last, iterator result,
+                        false_type) {
+    return mystl::uninitialized_move_if_noexcept(first, last, result);
+  }
+  void destroy_relocated(iterator first, iterator last) {
+    if (!is_trivially_relocatable<Tp>::value) destroy(first, last);
+  }
+  /* With trivially relocatable elements, insert() and erase() shift the 
+   * tail with memmove: open_gap() leaves n raw slots at pos, close_gap() 
+   * removes n raw slots at pos.
+   */
+  void open_gap(iterator pos, size_type n) {
+    __builtin_memmove(static_cast<void*>(pos + n), 
+                      static_cast<const void*>(pos), 
+                      (finish_ - pos) * sizeof(Tp));
+    finish_ += n;
+  }
+  void close_gap(iterator pos, size_type n) {
+    __builtin_memmove(static_cast<void*>(pos), 
+                      static_cast<const void*>(pos + n),
+                      (finish_ - pos - n) * sizeof(Tp));
+    finish_ -= n;
+  }
+  /* Removes the elements from first on for which pred returns true.
+   * Trivially relocatable elements with a nontrivial move are destroyed
+   * where they are and the runs of survivors between them are moved down
+   * with memmove; others are move-assigned down, which for trivially
+   * copyable elements is a plain copy, and the tail is destroyed. Either way, if pred
+   * throws, [write, read) holds no live elements and is closed.
+   */
+  template <typename Predicate>
+  size_type remove_from(iterator first, Predicate& pred) {
+    iterator last = finish_;
+    while (first != last && !pred(*first)) ++first;
+    if (first == last) return 0;
+    iterator write = first, read = first;
+    if (is_trivially_relocatable<Tp>::value &&
+        !is_trivially_copyable<Tp>::value) {
+      allocator_.destroy(first);
+      iterator run = first + 1;
+      try {
+        for (++read; read != last; ++read) {
+          if (pred(*read)) {
+            __builtin_memmove(static_cast<void*>(write),
+                              static_cast<const void*>(run),
+                              (read - run) * sizeof(Tp));
+            write += read - run;
+            allocator_.destroy(read);
+            run = read + 1;
+          }
+        }
+      } catch (...) {
+        close_gap(write, run - write);
+        throw;
+      }
+      close_gap(write, run - write);
+    } else {
+      try {
+        for (++read; read != last; ++read) {
+          if (!pred(*read)) {
+            *write = mystl::move(*read);
+            ++write;
+          }
+        }
+      } catch (...) {
+        erase(write, read);
+        throw;
+      }
+      destroy(write, last);
+      finish_ = write;
+    }
+    auto_trim(finish_);
+    return last - finish_;
+  }
+  // Tells erase_indices() which elements to remove, in increasing order.
+  template <typename InputIterator>
+  struct index_predicate {
+    const Tp* base;
+    InputIterator next;
+    InputIterator last;
+    bool operator()(const Tp& x) {
+      size_type i = &x - base;
+      if (next == last || size_type(*next) != i) return false;
+      while (next != last && size_type(*next) == i) ++next;
+      return true;
+    }
+  };
+  // Constructs n copies of value in the gap at pos, closing it on failure.
+  void fill_gap(iterator pos, size_type n, const Tp& value) {
+    if (is_trivially_copyable<Tp>::value) {
+      mystl::uninitialized_fill_n(pos, n, value);
+      return;
+    }
+    size_type i = 0;
+    try {
+      for (; i < n; ++i) allocator_.construct(pos + i, value);
+    } catch (...) {
+      destroy(pos, pos + i);
+      close_gap(pos, n);
+      throw;
+    }
+  }
+  template <typename ForwardIterator>
+  void copy_into_gap(iterator pos, size_type n, ForwardIterator first, 
+                     ForwardIterator last) {
+    if (is_trivially_copyable<Tp>::value) {
+      mystl::uninitialized_copy(first, last, pos);
+      return;
+    }
+    size_type i = 0;
+    try {
+      for (; i < n; ++i, ++first) allocator_.construct(pos + i, *first);
+    } catch (...) {
+      destroy(pos, pos + i);
+      close_gap(pos, n);
+      throw;
+    }
+  }
   void destroy(iterator first, iterator last) {
+    destroy_aux(first, last, typename is_trivially_destructible<Tp>::type());
+  }
+  void destroy_aux(iterator first, iterator last, true_type) {}
+  void destroy_aux(iterator first, iterator last, false_type) {
     for (; first != last; ++first) {
       allocator_.destroy(&*first);
     }
   }
   void destroy_and_deallocate() {
     destroy(start_, finish_);
+    deallocate();
+  }
+  void deallocate() {
+    if (start_ != 0) vector_stats<Tp>::on_deallocate(capacity(), size());
     allocator_.deallocate(start_, end_of_storage_ - start_);
   }
+  /* Stateful allocator support
+   * A buffer must be returned to an allocator equal to the one that 
+   * allocated it, so when allocators do not propagate and differ, the 
+   * elements are moved or copied one by one instead of handing the 
+   * buffer over.
+   */
+  void steal(vector& other) {
+    start_ = other.start_;
+    finish_ = other.finish_;
+    end_of_storage_ = other.end_of_storage_;
+    other.start_ = other.finish_ = other.end_of_storage_ = 0;
+  }
+  void move_from(vector& other) {
+    reserve(other.size());
+    finish_ = mystl::uninitialized_move(other.start_, other.finish_, start_);
+    other.clear();
+  }
+  void move_assign(vector& other, true_type) {
+    destroy_and_deallocate();
+    allocator_ = mystl::move(other.allocator_);
+    steal(other);
+  }
+  void move_assign(vector& other, false_type) {
+    if (allocator_ == other.allocator_) {
+      destroy_and_deallocate();
+      steal(other);
+    } else {
+      clear();
+      move_from(other);
+    }
+  }
+  void copy_assign_allocator(const Allocator& alloc, true_type) {
+    if (allocator_ != alloc) {
+      destroy_and_deallocate();
+      start_ = finish_ = end_of_storage_ = 0;
+    }
+    allocator_ = alloc;
+  }
+  void copy_assign_allocator(const Allocator& alloc, false_type) {}
+  void swap_allocator(vector& other, true_type) {
+    mystl::swap(allocator_, other.allocator_);
+  }
+  void swap_allocator(vector& other, false_type) {}
+  void replace_storage(iterator new_start, iterator new_finish, 
+                       size_type new_capacity) {
+    vector_stats<Tp>::on_reallocate(capacity(), new_capacity);
+    destroy_relocated(start_, finish_);
+    deallocate();
+    start_ = new_start;
+    finish_ = new_finish;
+    end_of_storage_ = new_start + new_capacity;
+  }
+  /* Changes the capacity to n >= size(), keeping the elements. With an
+   * allocator that has reallocate() and trivially relocatable elements 
+   * the buffer is resized in place of an allocate / relocate / deallocate
+   * round trip. Otherwise growth first tries expand_in_place().
+   */
+  typedef typename conditional<is_trivially_relocatable<Tp>::value,
+    typename allocator_traits<Allocator>::has_reallocate, 
+    false_type>::type can_reallocate;
+  void reallocate(size_type n) { reallocate_aux(n, can_reallocate()); }
+  // Reported as the allocate / relocate / deallocate round trip it stands
+  // for, so that the statistics do not depend on the allocator.
+  void reallocate_aux(size_type n, true_type) {
+    size_type old_size = size();
+    vector_stats<Tp>::on_allocate(n);
+    vector_stats<Tp>::on_relocate(old_size);
+    vector_stats<Tp>::on_reallocate(capacity(), n);
+    if (start_ != 0) vector_stats<Tp>::on_deallocate(capacity(), old_size);
+    start_ = allocator_.reallocate(start_, capacity(), n, old_size);
+    finish_ = start_ + old_size;
+    end_of_storage_ = start_ + n;
+  }
+  void reallocate_aux(size_type n, false_type) {
+    if (expand_in_place(n)) return;
+    size_type old_size = size();
+    iterator new_start = allocate_and_move(n, start_, finish_);
+    replace_storage(new_start, new_start + old_size, n);
+  }
+  // Grows the buffer to n elements without moving it, if the allocator can.
+  bool expand_in_place(size_type n) {
+    return n > capacity() && start_ != 0 && expand_in_place_aux(n, 
+      typename allocator_traits<Allocator>::has_expand_in_place());
+  }
+  bool expand_in_place_aux(size_type n, true_type) {
+    if (!allocator_.expand_in_place(start_, capacity(), n)) return false;
+    // Like a reallocation, except that no element moves.
+    vector_stats<Tp>::on_allocate(n);
+    vector_stats<Tp>::on_reallocate(capacity(), n);
+    vector_stats<Tp>::on_deallocate(capacity(), size());
+    end_of_storage_ = start_ + n;
+    return true;
+  }
+  bool expand_in_place_aux(size_type n, false_type) { return false; }
   void fill_assign(size_type n, const Tp& value) {
-    if (n > capacity()) {
-      swap(vector(n, value, get_allocator()));
+    if (n > capacity() && can_reallocate::value) {
+      Tp tmp(value);  // value may refer into *this
+      destroy(start_, finish_);
+      finish_ = start_;
+      reallocate(n);
+      finish_ = mystl::uninitialized_fill_n(start_, n, tmp);
+    } else if (n > capacity()) {
+      vector tmp(n, value, get_allocator());
+      swap(tmp);
     } else if (n > size()) {
-      fill(begin(), end(), value);
-      finish_ = uninitialized_fill_n(finish_, n - size(), value);
+      mystl::fill(begin(), end(), value);
+      finish_ = mystl::uninitialized_fill_n(finish_, n - size(), value);
     } else {
-      erase(fill_n(begin(), n, value), end());
+      erase(mystl::fill_n(begin(), n, value), end());
     }
   }
   template <typename InputIterator>
@@ -528,7 +1495,12 @@ protected:
   template <typename ForwardIterator>
   void assign_aux(ForwardIterator first, ForwardIterator last, 
                   forward_iterator_tag) {
-    size_type n = distance(first, last);
+    size_type n = mystl::distance(first, last);
+    if (n > capacity() && can_reallocate::value) {
+      destroy(start_, finish_);
+      finish_ = start_;
+      reallocate(n);
+    }
     if (n > capacity()) {
       iterator new_start = allocate_and_copy(n, first, last);
       destroy_and_deallocate();
@@ -537,68 +1509,117 @@ protected:
       end_of_storage_ = start_ + n;
     } else if (n > size()) {
       ForwardIterator mid = first;
-      advance(mid, size());
-      copy(first, mid, begin());
-      finish_ = uninitialized_copy(mid, last, finish_);
+      mystl::advance(mid, size());
+      mystl::copy(first, mid, begin());
+      finish_ = mystl::uninitialized_copy(mid, last, finish_);
     } else {
-      iterator new_finish = copy(first, last, begin());
+      iterator new_finish = mystl::copy(first, last, begin());
       destroy(new_finish, finish_);
       finish_ = new_finish;
     }
   }
+  size_type next_capacity(size_type n) const {
+    return GrowthPolicy::next_capacity(size(), n, sizeof(Tp));
+  }
+  // Makes room for n more elements with at most one reallocation.
+  void reserve_for_append(size_type n) {
+    if (size_type(end_of_storage_ - finish_) < n) {
+      reallocate(next_capacity(n));
+    }
+  }
+  /* Applies GrowthPolicy::trim_capacity() after elements were removed.
+   * Returns pos, relocated into the new buffer if the vector shrank.
+   */
+  iterator auto_trim(iterator pos) {
+    size_type n = GrowthPolicy::trim_capacity(size(), capacity());
+    if (n < capacity()) {
+      size_type offset = pos - start_;
+      shrink_to(n);
+      pos = start_ + offset;
+    }
+    return pos;
+  }
   void range_check(size_type n) {
     if (n >= size()) throw "Out-of-memory";
   }
-  void insert_aux(iterator pos, const Tp& value) {
-    if (finish_ != end_of_storage_) {
-      allocator_.construct(finish_, *(finish_ - 1));
+  template <typename... Args>
+  void emplace_aux(iterator pos, Args&&... args) {
+    if (finish_ != end_of_storage_ && is_trivially_relocatable<Tp>::value) {
+      // Built aside first, args may refer into *this
+      alignas(Tp) unsigned char tmp[sizeof(Tp)];
+      allocator_.construct(reinterpret_cast<Tp*>(tmp), 
+                           mystl::forward<Args>(args)...);
+      open_gap(pos, 1);
+      __builtin_memcpy(static_cast<void*>(pos), tmp, sizeof(Tp));
+    } else if (finish_ != end_of_storage_) {
+      Tp tmp(mystl::forward<Args>(args)...);  // args may refer into *this
+      allocator_.construct(finish_, mystl::move(*(finish_ - 1)));
       ++finish_;
-      copy_backward(pos, finish_ - 2, finish_ - 1);
-      *pos = value;
+      mystl::move_backward(pos, finish_ - 2, finish_ - 1);
+      *pos = mystl::move(tmp);
+    } else if (can_reallocate::value) {
+      Tp tmp(mystl::forward<Args>(args)...);  // args may refer into *this
+      size_type offset = pos - start_;
+      reallocate(next_capacity(1));
+      emplace(start_ + offset, mystl::move(tmp));
+    } else if (expand_in_place(next_capacity(1))) {
+      emplace(pos, mystl::forward<Args>(args)...);
     } else {
-      size_type old_size = size();
-      size_type new_capacity = old_size != 0 ? 2 * old_size : 1;
-      iterator new_start = allocator_.allocate(new_capacity);
-      iterator new_finish = uninitialized_copy(start_, pos, new_start);
-      allocator_.construct(new_finish, value);
-      ++new_finish;
-      new_finish = uninitialized_copy(pos, finish_, new_finish);
-      destroy_and_deallocate();
-      start_ = new_start;
-      finish_ = new_finish;
-      end_of_storage_ = start_ + new_capacity;
+      size_type new_capacity = next_capacity(1);
+      // The compiler must assume that allocate() may change finish_.
+      iterator old_finish = finish_;
+      iterator new_start = allocate(new_capacity);
+      iterator new_pos = new_start + (pos - start_);
+      allocator_.construct(new_pos, mystl::forward<Args>(args)...);
+      relocate(start_, pos, new_start);
+      iterator new_finish = relocate(pos, old_finish, new_pos + 1);
+      replace_storage(new_start, new_finish, new_capacity);
     }
   }
   void insert_aux(iterator pos, size_type n, const Tp& value) {
-    if (finish_ + n - 1 != end_of_storage_) {
+    if (n == 0) return;
+    if (size_type(end_of_storage_ - finish_) >= n && 
+        is_trivially_relocatable<Tp>::value) {
+      Tp tmp(value);  // value may refer into *this
+      open_gap(pos, n);
+      fill_gap(pos, n, tmp);
+    } else if (size_type(end_of_storage_ - finish_) >= n) {
+      Tp tmp(value);  // value may refer into *this
+      size_type back_len = finish_ - pos;
       iterator old_finish = finish_;
-      uninitialized_copy(finish_ - n, finish_, finish_);
-      finish_ += n;
-      copy_backward(pos, old_finish - n, old_finish);
-      fill_n(pos, n, value);
+      if (back_len > n) {
+        mystl::uninitialized_move(finish_ - n, finish_, finish_);
+        finish_ += n;
+        mystl::move_backward(pos, old_finish - n, old_finish);
+        mystl::fill_n(pos, n, tmp);
+      } else {
+        finish_ = mystl::uninitialized_fill_n(finish_, n - back_len, tmp);
+        mystl::uninitialized_move(pos, old_finish, finish_);
+        finish_ += back_len;
+        mystl::fill(pos, old_finish, tmp);
+      }
+    } else if (can_reallocate::value) {
+      Tp tmp(value);  // value may refer into *this
+      size_type offset = pos - start_;
+      reallocate(next_capacity(n));
+      insert_aux(start_ + offset, n, tmp);
+    } else if (expand_in_place(next_capacity(n))) {
+      insert_aux(pos, n, value);
     } else {
-      size_type old_size = size();
-      size_type new_capacity = old_size >= n ? 2 * old_size : old_size + n;
-      iterator new_start = allocator_.allocate(new_capacity);
-      iterator new_finish = uninitialized_copy(start_, pos, new_start);
-      fill_n(pos, n, value);
-      new_finish += n;
-      new_finish = uninitialized_copy(pos, finish_, new_finish);
-      destroy_and_deallocate();
-      start_ = new_start;
-      finish_ = new_finish;
-      end_of_storage_ = start_ + new_capacity;
+      size_type new_capacity = next_capacity(n);
+      // The compiler must assume that allocate() may change finish_.
+      iterator old_finish = finish_;
+      iterator new_start = allocate(new_capacity);
+      iterator new_pos = new_start + (pos - start_);
+      mystl::uninitialized_fill_n(new_pos, n, value);
+      relocate(start_, pos, new_start);
+      iterator new_finish = relocate(pos, old_finish, new_pos + n);
+      replace_storage(new_start, new_finish, new_capacity);
     }
   }
   template <typename Integral>
   iterator insert_aux(iterator pos, Integral n, Integral value, true_type) {
-    if (finish_ + n - 1 != end_of_storage_ && pos == end()) {
-      uninitialized_fill_n(finish_, n, value);
-      finish_ += n;
-    } else {
-      insert_aux(pos, n, value);
-    }
-    return begin() + n;    
+    return insert(pos, size_type(n), Tp(value));
   }
   template <typename InputIterator>
   iterator insert_aux(iterator pos, InputIterator first, InputIterator last,
@@ -620,35 +1641,44 @@ protected:
   void range_insert(iterator pos, ForwardIterator first, ForwardIterator last,
                     forward_iterator_tag) {
     if (first == last) return;
-    size_type n = distance(first, last);
-    if (n <= size_type(end_of_storage_ - finish_)) {
+    size_type n = mystl::distance(first, last);
+    if (n <= size_type(end_of_storage_ - finish_) && 
+        is_trivially_relocatable<Tp>::value) {
+      open_gap(pos, n);
+      copy_into_gap(pos, n, first, last);
+    } else if (n <= size_type(end_of_storage_ - finish_)) {
       size_type back_len = finish_ - pos;
       iterator old_finish = finish_;
       if (back_len > n) {
-        uninitialized_copy(finish_ - n, finish_, finish_);
+        mystl::uninitialized_move(finish_ - n, finish_, finish_);
         finish_ += n;
-        copy_backward(pos, old_finish - n, old_finish);
-        copy(first, last, pos);
+        mystl::move_backward(pos, old_finish - n, old_finish);
+        mystl::copy(first, last, pos);
       } else {
         ForwardIterator mid = first;
-        advance(mid, back_len);
-        uninitialized_copy(mid, last, finish_);
+        mystl::advance(mid, back_len);
+        mystl::uninitialized_copy(mid, last, finish_);
         finish_ += n - back_len;
-        uninitialized_copy(pos, old_finish, finish_);
+        mystl::uninitialized_move(pos, old_finish, finish_);
         finish_ += back_len;
-        copy(first, mid, pos);
+        mystl::copy(first, mid, pos);
       }
+    } else if (can_reallocate::value) {
+      size_type offset = pos - start_;
+      reallocate(next_capacity(n));
+      range_insert(start_ + offset, first, last, forward_iterator_tag());
+    } else if (expand_in_place(next_capacity(n))) {
+      range_insert(pos, first, last, forward_iterator_tag());
     } else {
-      size_type old_size = size();
-      size_type new_capacity = old_size >= n ? 2 * old_size : old_size + n;
-      iterator new_start = allocator_.allocate(new_capacity);
-      iterator new_finish = uninitialized_copy(start_, pos, new_start);
-      new_finish = uninitialized_copy(first, last, new_finish);
-      new_finish = uninitialized_copy(pos, finish_, new_finish);
-      destroy_and_deallocate();
-      start_ = new_start;
-      finish_ = new_finish;
-      end_of_storage_ = start_ + new_capacity;      
+      size_type new_capacity = next_capacity(n);
+      // The compiler must assume that allocate() may change finish_.
+      iterator old_finish = finish_;
+      iterator new_start = allocate(new_capacity);
+      iterator new_pos = new_start + (pos - start_);
+      mystl::uninitialized_copy(first, last, new_pos);
+      relocate(start_, pos, new_start);
+      iterator new_finish = relocate(pos, old_finish, new_pos + n);
+      replace_storage(new_start, new_finish, new_capacity);
     }
   }
 
@@ -658,49 +1688,82 @@ protected:
   Allocator allocator_;
 };
 
-template <typename Tp, typename Allocator>
-bool operator==(const vector<Tp, Allocator>& x, 
-                const vector<Tp, Allocator>& y) {
-  if (x.size() != y.size()) return false;
-  typename vector<Tp, Allocator>::const_iterator 
-           it_x = x.cbegin(), it_y = y.cbegin();
-  for (; it_x != x.cend(); ++it_x, ++it_y) {
-    if (*it_x != *it_y) return false;
+/* Comparisons of vectors of integral types compare raw memory: equality
+ * with memcmp, ordering by locating the first mismatching element with 
+ * mismatch_bytes() and comparing only that element.
+ */
+template <typename Tp>
+inline bool equal_aux(const Tp* x, const Tp* y, size_t n, true_type) {
+  return n == 0 || __builtin_memcmp(x, y, n * sizeof(Tp)) == 0;
+}
+template <typename Tp>
+inline bool equal_aux(const Tp* x, const Tp* y, size_t n, false_type) {
+  for (; n > 0; --n, ++x, ++y) {
+    if (*x != *y) return false;
   }
   return true;
 }
-template <typename Tp, typename Allocator>
-bool operator<(const vector<Tp, Allocator>& x, 
-               const vector<Tp, Allocator>& y) {
-  typename vector<Tp, Allocator>::const_iterator 
-           it_x = x.cbegin(), it_y = y.cbegin();
-  for (; it_x != x.cend() && it_y != y.cend(); ++it_x, ++it_y) {
-    if (*it_x < *it_y) return true;
-    if (*it_y < *it_x) return false;
+template <typename Tp>
+inline bool less_aux(const Tp* x, size_t nx, const Tp* y, size_t ny, 
+                     true_type) {
+  size_t n = nx < ny ? nx : ny;
+  size_t i = n == 0 ? 0 : mismatch_bytes(x, y, n * sizeof(Tp)) / sizeof(Tp);
+  return i < n ? x[i] < y[i] : nx < ny;
+}
+template <typename Tp>
+inline bool less_aux(const Tp* x, size_t nx, const Tp* y, size_t ny, 
+                     false_type) {
+  size_t n = nx < ny ? nx : ny;
+  for (size_t i = 0; i < n; ++i) {
+    if (x[i] < y[i]) return true;
+    if (y[i] < x[i]) return false;
   }
-  return it_x == x.cend() && it_y != y.cend();
+  return nx < ny;
 }
-template <typename Tp, typename Allocator>
-bool operator!=(const vector<Tp, Allocator>& x, 
-                const vector<Tp, Allocator>& y) {
+
+// A vector owns its buffer through pointers, which survive a byte copy.
+template <typename Tp>
+struct is_trivially_relocatable<new_allocator<Tp>> : true_type {};
+template <typename Tp, typename Allocator, typename GrowthPolicy>
+struct is_trivially_relocatable<vector<Tp, Allocator, GrowthPolicy>> :
+  is_trivially_relocatable<Allocator> {};
+
+template <typename Tp, typename Allocator, typename GrowthPolicy>
+bool operator==(const vector<Tp, Allocator, GrowthPolicy>& x, 
+                const vector<Tp, Allocator, GrowthPolicy>& y) {
+  if (x.size() != y.size()) return false;
+  return mystl::equal_aux(x.data(), y.data(), x.size(), 
+                          typename is_integral<Tp>::type());
+}
+template <typename Tp, typename Allocator, typename GrowthPolicy>
+bool operator<(const vector<Tp, Allocator, GrowthPolicy>& x, 
+               const vector<Tp, Allocator, GrowthPolicy>& y) {
+  return mystl::less_aux(x.data(), x.size(), y.data(), y.size(),
+                         typename is_integral<Tp>::type());
+}
+template <typename Tp, typename Allocator, typename GrowthPolicy>
+bool operator!=(const vector<Tp, Allocator, GrowthPolicy>& x, 
+                const vector<Tp, Allocator, GrowthPolicy>& y) {
   return !(x == y);
 }
-template <typename Tp, typename Allocator>
-bool operator>(const vector<Tp, Allocator>& x, 
-               const vector<Tp, Allocator>& y) {
+template <typename Tp, typename Allocator, typename GrowthPolicy>
+bool operator>(const vector<Tp, Allocator, GrowthPolicy>& x, 
+               const vector<Tp, Allocator, GrowthPolicy>& y) {
   return y < x;
 }
-template <typename Tp, typename Allocator>
-bool operator<=(const vector<Tp, Allocator>& x, 
-                const vector<Tp, Allocator>& y) {
+template <typename Tp, typename Allocator, typename GrowthPolicy>
+bool operator<=(const vector<Tp, Allocator, GrowthPolicy>& x, 
+                const vector<Tp, Allocator, GrowthPolicy>& y) {
   return !(y < x);
 }
-template <typename Tp, typename Allocator>
-bool operator>=(const vector<Tp, Allocator>& x, 
-                const vector<Tp, Allocator>& y) {
+template <typename Tp, typename Allocator, typename GrowthPolicy>
+bool operator>=(const vector<Tp, Allocator, GrowthPolicy>& x, 
+                const vector<Tp, Allocator, GrowthPolicy>& y) {
   return !(x < y);
 }
 
 }  // namespace mystl
 
+#include "bit_vector.h"  // vector<bool>
+
 #endif  // MYSTL_VECTOR_H
\ No newline at end of file
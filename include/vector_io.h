@@ -0,0 +1,335 @@
+/*
+ * Copyright 2016 Waizung Taam
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ==== Binary I/O of vectors ====
+ *
+ * write_to() and read_from() save and restore a vector of a trivially
+ * copyable type through a file descriptor, without formatting elements
+ * one by one:
+ *
+ *   mystl::write_to(fd, index);         // header and data in one writev()
+ *   mystl::read_from(fd, index);        // one allocation, read() into it
+ *
+ * vector_reader<Tp> reads the same stream in chunks of a chosen size, for
+ * inputs that need not fit in memory at once:
+ *
+ *   mystl::vector_reader<Entry> reader(fd);
+ *   mystl::vector<Entry> chunk;
+ *   while (reader.read(chunk, 1 << 20) > 0) {
+ *     process(chunk);
+ *     chunk.clear();                    // keeps the buffer for the next
+ *   }
+ *
+ * A stream is a vector_io_header followed by the bytes of the elements:
+ *
+ *   magic "mystlvio", version, byte order mark, element size, element
+ *   count, checksum of the element bytes
+ *
+ * Like mmap_vector files, the data is the in-memory representation of Tp,
+ * so a stream can only be read by a build with the same ABI. A stream
+ * written on a host of the other byte order is rejected rather than
+ * converted.
+ *
+ * The element count in a header is not trusted: from a regular file it
+ * must fit in the bytes that follow the header, and from a pipe or socket
+ * read_from() grows the vector chunk by chunk as the data arrives, so a
+ * corrupt count never allocates more than the stream holds.
+ *
+ * Errors are thrown as "vector_io: ..." strings. A vector that read_from()
+ * fails to fill is left empty; one that vector_reader::read() fails to
+ * fill keeps the elements it had.
+ */
+
+/* - vector_checksum
+ * - vector_io_header
+ * - write_fully(), read_fully(), bytes_left()
+ * - write_to(), read_from()
+ * - vector_reader<Tp>
+ */
+#ifndef MYSTL_VECTOR_IO_H
+#define MYSTL_VECTOR_IO_H
+
+#include <errno.h>
+#include <stdint.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "vector.h"
+
+namespace mystl {
+
+/* vector_checksum
+ * A 64-bit hash of a byte stream that may be fed in pieces of any size.
+ * Four independent lanes each mix one 8-byte word per 32-byte stripe, in
+ * the manner of xxHash64, so hashing runs at several bytes per cycle and
+ * costs little next to the I/O.
+ */
+class vector_checksum {
+public:
+  vector_checksum() : bytes_(0), buffered_(0) {
+    lanes_[0] = seed + prime1 + prime2;
+    lanes_[1] = seed + prime2;
+    lanes_[2] = seed;
+    lanes_[3] = seed - prime1;
+  }
+
+  void update(const void* data, size_t n) {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    bytes_ += n;
+    if (buffered_ > 0) {
+      size_t m = stripe_size - buffered_ < n ? stripe_size - buffered_ : n;
+      __builtin_memcpy(buffer_ + buffered_, p, m);
+      buffered_ += m;
+      p += m;
+      n -= m;
+      if (buffered_ < stripe_size) return;
+      stripe(buffer_);
+      buffered_ = 0;
+    }
+    for (; n >= stripe_size; p += stripe_size, n -= stripe_size) stripe(p);
+    __builtin_memcpy(buffer_, p, n);
+    buffered_ = n;
+  }
+  uint64_t value() const {
+    uint64_t h = rotl(lanes_[0], 1) + rotl(lanes_[1], 7) +
+                 rotl(lanes_[2], 12) + rotl(lanes_[3], 18) + bytes_;
+    for (size_t i = 0; i < buffered_; ++i) {
+      h = rotl(h ^ (buffer_[i] * prime3), 11) * prime1;
+    }
+    h ^= h >> 33;
+    h *= prime2;
+    h ^= h >> 29;
+    h *= prime3;
+    h ^= h >> 32;
+    return h;
+  }
+
+private:
+  static const size_t stripe_size = 32;
+  static const uint64_t seed = 0x6d7973746c76696fULL;  // "mystlvio"
+  static const uint64_t prime1 = 0x9e3779b185ebca87ULL;
+  static const uint64_t prime2 = 0xc2b2ae3d27d4eb4fULL;
+  static const uint64_t prime3 = 0x165667b19e3779f9ULL;
+
+  static uint64_t rotl(uint64_t x, int r) {
+    return (x << r) | (x >> (64 - r));
+  }
+  void stripe(const unsigned char* p) {
+    for (int k = 0; k < 4; ++k) {
+      uint64_t word;
+      __builtin_memcpy(&word, p + 8 * k, 8);
+      lanes_[k] = rotl(lanes_[k] + word * prime2, 31) * prime1;
+    }
+  }
+
+  uint64_t lanes_[4];
+  uint64_t bytes_;
+  size_t buffered_;
+  unsigned char buffer_[stripe_size];
+};
+
+struct vector_io_header {
+  static const uint32_t current_version = 1;
+  static const uint32_t byte_order_mark = 0x01020304;
+
+  char magic[8];
+  uint32_t version;
+  uint32_t byte_order;
+  uint64_t element_size;
+  uint64_t size;
+  uint64_t checksum;
+};
+
+/* Writes the buffers of iov in order, resuming after short writes and
+ * interrupted calls. iov is modified.
+ */
+inline void write_fully(int fd, struct iovec* iov, int count) {
+  while (count > 0) {
+    ssize_t n = ::writev(fd, iov, count);
+    if (n < 0) {
+      if (errno == EINTR) continue;
+      throw "vector_io: write failed";
+    }
+    size_t done = n;
+    while (count > 0 && done >= iov->iov_len) {
+      done -= iov->iov_len;
+      ++iov;
+      --count;
+    }
+    if (count > 0) {
+      iov->iov_base = static_cast<char*>(iov->iov_base) + done;
+      iov->iov_len -= done;
+    }
+  }
+}
+// Reads exactly n bytes into p.
+inline void read_fully(int fd, void* p, size_t n) {
+  char* first = static_cast<char*>(p);
+  while (n > 0) {
+    ssize_t m = ::read(fd, first, n);
+    if (m < 0) {
+      if (errno == EINTR) continue;
+      throw "vector_io: read failed";
+    }
+    if (m == 0) throw "vector_io: unexpected end of stream";
+    first += m;
+    n -= m;
+  }
+}
+
+/* Stores in *bytes how many bytes of fd lie past its offset, if fd is a
+ * regular file; returns false for pipes, sockets and the like.
+ */
+inline bool bytes_left(int fd, uint64_t* bytes) {
+  struct stat st;
+  if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) return false;
+  off_t offset = ::lseek(fd, 0, SEEK_CUR);
+  if (offset < 0) return false;
+  *bytes = st.st_size > offset ? uint64_t(st.st_size - offset) : 0;
+  return true;
+}
+
+/* write_to
+ * Writes v as one stream: the header and the elements go out in a single
+ * writev(), straight from v.data().
+ */
+template <typename Tp, typename Allocator, typename GrowthPolicy>
+void write_to(int fd, const vector<Tp, Allocator, GrowthPolicy>& v) {
+  static_assert(is_trivially_copyable<Tp>::value,
+                "write_to() requires a trivially copyable element type");
+  vector_checksum checksum;
+  checksum.update(v.data(), v.size() * sizeof(Tp));
+  vector_io_header header;
+  __builtin_memcpy(header.magic, "mystlvio", 8);
+  header.version = vector_io_header::current_version;
+  header.byte_order = vector_io_header::byte_order_mark;
+  header.element_size = sizeof(Tp);
+  header.size = v.size();
+  header.checksum = checksum.value();
+  struct iovec iov[2];
+  iov[0].iov_base = &header;
+  iov[0].iov_len = sizeof(header);
+  iov[1].iov_base = const_cast<Tp*>(v.data());
+  iov[1].iov_len = v.size() * sizeof(Tp);
+  write_fully(fd, iov, v.empty() ? 1 : 2);
+}
+
+/* vector_reader
+ * Reads the header of a stream on construction, then its elements in as
+ * many read() calls as the caller likes. The checksum is verified when
+ * the last element has been read. bounded() tells whether the element
+ * count was checked against the size of the file.
+ */
+template <typename Tp>
+class vector_reader {
+public:
+  static_assert(is_trivially_copyable<Tp>::value,
+                "vector_reader requires a trivially copyable element type");
+
+  explicit vector_reader(int fd) : fd_(fd), remaining_(0), bounded_(false) {
+    read_fully(fd_, &header_, sizeof(header_));
+    if (__builtin_memcmp(header_.magic, "mystlvio", 8) != 0 ||
+        header_.version != vector_io_header::current_version) {
+      throw "vector_io: not a vector stream";
+    }
+    if (header_.byte_order != vector_io_header::byte_order_mark) {
+      throw "vector_io: stream has the other byte order";
+    }
+    if (header_.element_size != sizeof(Tp)) {
+      throw "vector_io: element size mismatch";
+    }
+    if (header_.size > size_t(-1) / sizeof(Tp)) {
+      throw "vector_io: element count too large";
+    }
+    uint64_t bytes;
+    if (bytes_left(fd_, &bytes)) {
+      if (header_.size > bytes / sizeof(Tp)) {
+        throw "vector_io: element count exceeds the stream";
+      }
+      bounded_ = true;
+    }
+    remaining_ = header_.size;
+    if (remaining_ == 0 && checksum_.value() != header_.checksum) {
+      throw "vector_io: checksum mismatch";
+    }
+  }
+
+  // The number of elements in the stream, and of those not yet read.
+  size_t size() const { return header_.size; }
+  size_t remaining() const { return remaining_; }
+  bool bounded() const { return bounded_; }
+
+  /* Appends up to n of the remaining elements to v and returns how many.
+   * They are read directly into v's storage, which grows at most once.
+   */
+  template <typename Allocator, typename GrowthPolicy>
+  size_t read(vector<Tp, Allocator, GrowthPolicy>& v, size_t n) {
+    if (n > remaining_) n = remaining_;
+    if (n == 0) return 0;
+    size_t old_size = v.size();
+    Tp* p = v.append_uninitialized(n);
+    try {
+      read_fully(fd_, p, n * sizeof(Tp));
+    } catch (...) {
+      v.resize_default_init(old_size);
+      throw;
+    }
+    checksum_.update(p, n * sizeof(Tp));
+    remaining_ -= n;
+    if (remaining_ == 0 && checksum_.value() != header_.checksum) {
+      v.resize_default_init(old_size);
+      throw "vector_io: checksum mismatch";
+    }
+    return n;
+  }
+
+private:
+  int fd_;
+  vector_io_header header_;
+  size_t remaining_;
+  bool bounded_;
+  vector_checksum checksum_;
+};
+
+/* read_from
+ * Replaces the contents of v with a stream written by write_to(). From a
+ * regular file the storage is allocated once, for exactly the stored size
+ * unless v already has room, and the elements are read into it with no
+ * copy in between. Otherwise the stored size is unchecked, and the
+ * elements are read in chunks of about 1 MiB, v growing as they arrive.
+ */
+template <typename Tp, typename Allocator, typename GrowthPolicy>
+void read_from(int fd, vector<Tp, Allocator, GrowthPolicy>& v) {
+  vector_reader<Tp> reader(fd);
+  v.clear();
+  try {
+    if (reader.bounded()) {
+      v.reserve(reader.size());
+      reader.read(v, reader.size());
+    } else {
+      size_t chunk = sizeof(Tp) < (1 << 20) ? (1 << 20) / sizeof(Tp) : 1;
+      while (reader.read(v, chunk) > 0) {}
+    }
+  } catch (...) {
+    v.clear();
+    throw;
+  }
+}
+
+}  // namespace mystl
+
+#endif  // MYSTL_VECTOR_IO_H
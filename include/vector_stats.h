@@ -0,0 +1,174 @@
+/*
+ * Copyright 2016 Waizung Taam
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ==== vector allocation statistics ====
+ *
+ * Compiled in when MYSTL_VECTOR_STATS is defined before vector.h is
+ * included, e.g. with -DMYSTL_VECTOR_STATS. vector then reports every
+ * allocation, relocation, copy and deallocation of its buffer to
+ * vector_stats<Tp>, which keeps per-element-type counters and links
+ * itself into a global registry on first use:
+ *
+ *   mystl::vector_stats_report(stderr);
+ *
+ * Without MYSTL_VECTOR_STATS, vector.h defines vector_stats<Tp> with empty
+ * inline hooks instead, which compile to nothing.
+ *
+ * Counters are updated with relaxed atomics, so vectors may be used from
+ * several threads; a report taken while they run is not a snapshot.
+ */
+
+/* - vector_stats_entry
+ * - vector_stats_registry()
+ * - vector_stats<Tp>
+ *   - on_allocate(), on_relocate(), on_copy()
+ *   - on_reallocate(), on_deallocate()
+ * - vector_stats_report()
+ * - vector_stats_reset()
+ */
+#ifndef MYSTL_VECTOR_STATS_H
+#define MYSTL_VECTOR_STATS_H
+
+#include <cstdio>
+
+namespace mystl {
+
+struct vector_stats_entry {
+  const char* type_name;
+  int type_name_length;
+  unsigned long element_size;
+  unsigned long allocations;
+  unsigned long reallocations;
+  unsigned long bytes_allocated;
+  unsigned long bytes_relocated;   // moved or copied by growth and shrink
+  unsigned long bytes_copied;      // copied from other ranges on assignment
+  unsigned long peak_capacity;     // largest buffer, in elements
+  unsigned long wasted_bytes;      // unused capacity of released buffers
+  vector_stats_entry* next;
+};
+
+inline vector_stats_entry*& vector_stats_registry() {
+  static vector_stats_entry* head = 0;
+  return head;
+}
+
+template <typename Tp>
+struct vector_stats {
+  static void on_allocate(unsigned long n) {
+    vector_stats_entry& e = entry();
+    add(e.allocations, 1);
+    add(e.bytes_allocated, n * sizeof(Tp));
+    unsigned long peak = __atomic_load_n(&e.peak_capacity, __ATOMIC_RELAXED);
+    while (n > peak && !__atomic_compare_exchange_n(
+      &e.peak_capacity, &peak, n, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    }
+  }
+  static void on_relocate(unsigned long n) {
+    add(entry().bytes_relocated, n * sizeof(Tp));
+  }
+  static void on_copy(unsigned long n) {
+    add(entry().bytes_copied, n * sizeof(Tp));
+  }
+  static void on_reallocate(unsigned long old_capacity,
+                            unsigned long new_capacity) {
+    if (old_capacity != 0 && new_capacity != 0) {
+      add(entry().reallocations, 1);
+    }
+  }
+  static void on_deallocate(unsigned long capacity, unsigned long size) {
+    add(entry().wasted_bytes, (capacity - size) * sizeof(Tp));
+  }
+
+  static vector_stats_entry& entry() {
+    static vector_stats_entry e = make_entry();
+    static bool registered = link(&e);
+    (void)registered;
+    return e;
+  }
+
+private:
+  static void add(unsigned long& counter, unsigned long n) {
+    __atomic_fetch_add(&counter, n, __ATOMIC_RELAXED);
+  }
+  // "... [with Tp = int]" in the pretty function name gives the type.
+  static const char* type_name(int* length) {
+    const char* name = __PRETTY_FUNCTION__;
+    const char* begin = name;
+    while (*begin != '\0' && !(begin[0] == 'T' && begin[1] == 'p' &&
+                               begin[2] == ' ' && begin[3] == '=')) {
+      ++begin;
+    }
+    if (*begin == '\0') {
+      *length = 0;
+      return name;
+    }
+    begin += 5;
+    const char* end = begin;
+    int depth = 0;
+    for (; *end != '\0'; ++end) {
+      if (*end == '<' || *end == '[') ++depth;
+      if (*end == '>' || *end == ']') {
+        if (depth == 0) break;
+        --depth;
+      }
+      if (depth == 0 && *end == ';') break;
+    }
+    *length = int(end - begin);
+    return begin;
+  }
+  static vector_stats_entry make_entry() {
+    vector_stats_entry e = {0, 0, sizeof(Tp), 0, 0, 0, 0, 0, 0, 0, 0};
+    e.type_name = type_name(&e.type_name_length);
+    return e;
+  }
+  static bool link(vector_stats_entry* e) {
+    e->next = __atomic_load_n(&vector_stats_registry(), __ATOMIC_RELAXED);
+    while (!__atomic_compare_exchange_n(&vector_stats_registry(), &e->next,
+           e, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED)) {
+    }
+    return true;
+  }
+};
+
+inline void vector_stats_report(std::FILE* out) {
+  std::fprintf(out, "%-32s %8s %10s %10s %14s %14s %14s %12s %14s\n",
+               "type", "sizeof", "allocs", "reallocs", "alloc bytes",
+               "reloc bytes", "copy bytes", "peak cap", "wasted bytes");
+  for (vector_stats_entry* e = __atomic_load_n(&vector_stats_registry(),
+                                               __ATOMIC_ACQUIRE);
+       e != 0; e = e->next) {
+    if (e->allocations == 0) continue;
+    std::fprintf(out, "%-32.*s %8lu %10lu %10lu %14lu %14lu %14lu %12lu "
+                 "%14lu\n", e->type_name_length, e->type_name,
+                 e->element_size, e->allocations, e->reallocations,
+                 e->bytes_allocated, e->bytes_relocated, e->bytes_copied,
+                 e->peak_capacity, e->wasted_bytes);
+  }
+}
+
+inline void vector_stats_reset() {
+  for (vector_stats_entry* e = __atomic_load_n(&vector_stats_registry(),
+                                               __ATOMIC_ACQUIRE);
+       e != 0; e = e->next) {
+    e->allocations = e->reallocations = 0;
+    e->bytes_allocated = e->bytes_relocated = e->bytes_copied = 0;
+    e->peak_capacity = e->wasted_bytes = 0;
+  }
+}
+
+}  // namespace mystl
+
+#endif  // MYSTL_VECTOR_STATS_H
@@ -0,0 +1,66 @@
+/*
+ * Copyright 2016 Waizung Taam
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ==== allocator demo ==== */
+
+// $ valgrind --leak-check=full ./allocator_demo.o
+
+#include "../include/allocator.h"
+
+
+#include <iostream>
+
+template <typename Vector>
+void print(const Vector& v) {
+  std::cout << "size: " << v.size() << "\tcapacity: " << v.capacity() << "\t";
+  for (const int& x : v) std::cout << x << " ";
+  std::cout << "\n";  
+}
+
+int main() {
+  typedef mystl::vector<int, mystl::arena_allocator<int>> ArenaVector;
+  mystl::monotonic_arena arena;
+  {
+    ArenaVector a{mystl::arena_allocator<int>(&arena)};
+    for (int i = 0; i < 10; ++i) {
+      a.push_back(i);
+    }
+    print(a);
+    ArenaVector b(a);
+    b.push_back(10);
+    print(b);
+    ArenaVector c;
+    c = b;
+    print(c);
+    std::cout << "same arena: " << (c.get_allocator() == a.get_allocator()) 
+              << "\n";
+  }
+  arena.reset();
+
+  typedef mystl::vector<int, mystl::pool_allocator<int>> PoolVector;
+  mystl::fixed_pool pool(16 * sizeof(int));
+  {
+    PoolVector d{mystl::pool_allocator<int>(&pool)};
+    for (int i = 0; i < 20; ++i) {
+      d.push_back(i);
+    }
+    print(d);
+    PoolVector e{mystl::pool_allocator<int>(&pool)};
+    e = mystl::move(d);
+    print(d);
+    print(e);
+  }
+}
@@ -0,0 +1,73 @@
+/*
+ * Copyright 2016 Waizung Taam
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ==== vector<bool> demo ==== */
+
+// $ valgrind --leak-check=full ./bit_vector_demo.o
+
+#include "../include/vector.h"
+
+#include <iostream>
+
+typedef mystl::vector<bool> Bits;
+
+void print(const Bits& v) {
+  std::cout << "size: " << v.size() << "\tcapacity: " << v.capacity() 
+            << "\tcount: " << v.count() << "\t";
+  for (Bits::const_iterator it = v.begin(); it != v.end(); ++it) {
+    std::cout << *it;
+  }
+  std::cout << "\n";
+}
+
+int main() {
+  Bits a;
+  for (int i = 0; i < 10; ++i) a.push_back(i % 3 == 0);
+  print(a);
+  a[1] = true;
+  a[0].flip();
+  a.insert(a.begin() + 2, 3, true);
+  print(a);
+  a.erase(a.begin(), a.begin() + 4);
+  print(a);
+
+  Bits b(70, false);
+  b.fill(60, 5, true);
+  b[3] = true;
+  print(b);
+  std::cout << "set bits:";
+  for (size_t i = b.find_first(); i < b.size(); i = b.find_next(i)) {
+    std::cout << " " << i;
+  }
+  std::cout << "\n";
+
+  Bits c(70, false);
+  for (size_t i = 0; i < c.size(); i += 2) c[i] = true;
+  print(b & c);
+  print(b | c);
+  print(b ^ c);
+  print(~b);
+  std::cout << "b < c: " << (b < c) << "\tb == b: " << (b == b) << "\n";
+
+  // 10^9 bits take 125 MB instead of 1 GB.
+  Bits big(1000000000, false);
+  big[999999999] = true;
+  std::cout << "bytes: " << big.word_count() * sizeof(mystl::bit_word) 
+            << "\tfirst: " << big.find_first() << "\n";
+  // Counted in bits, saturating where the word count times 64 overflows.
+  std::cout << "max_size: " << big.max_size() << "\tof words: "
+            << mystl::vector<mystl::bit_word>().max_size() << "\n";
+}
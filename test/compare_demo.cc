@@ -0,0 +1,149 @@
+/*
+ * Copyright 2016 Waizung Taam
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ==== vector comparison demo ==== */
+
+// $ ./compare_demo.o
+//
+// Checks the mismatch kernels and operator== / operator< of vectors of
+// integral types against element-wise loops, around the 16 and 32 byte
+// block sizes and with a difference at every position, including the
+// overlapping tail. Prints the number of failed cases per check and
+// returns 1 if any failed.
+
+#include "../include/vector.h"
+
+#include <iostream>
+
+const size_t lengths[] = {0, 1, 15, 16, 17, 31, 32, 33, 63, 64, 65, 100};
+const size_t length_count = sizeof(lengths) / sizeof(lengths[0]);
+
+unsigned long long seed = 1;
+unsigned next_random() {
+  seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+  return unsigned(seed >> 33);
+}
+
+size_t naive_mismatch(const unsigned char* x, const unsigned char* y,
+                      size_t n) {
+  size_t i = 0;
+  while (i < n && x[i] == y[i]) ++i;
+  return i;
+}
+
+typedef size_t (*kernel)(const unsigned char*, const unsigned char*, size_t);
+
+// Every length, with no difference and with one at each byte.
+int check_kernel(const char* name, kernel f) {
+  int failures = 0;
+  unsigned char x[100], y[100];
+  for (size_t l = 0; l < length_count; ++l) {
+    size_t n = lengths[l];
+    for (size_t i = 0; i < n; ++i) x[i] = y[i] = next_random();
+    if (f(x, y, n) != n) ++failures;
+    for (size_t d = 0; d < n; ++d) {
+      y[d] ^= 1 + next_random() % 255;
+      if (f(x, y, n) != naive_mismatch(x, y, n)) ++failures;
+      y[d] = x[d];
+    }
+  }
+  std::cout << name << ": " << failures << " failed\n";
+  return failures;
+}
+
+template <typename Tp>
+bool naive_equal(const mystl::vector<Tp>& x, const mystl::vector<Tp>& y) {
+  if (x.size() != y.size()) return false;
+  for (size_t i = 0; i < x.size(); ++i) {
+    if (x[i] != y[i]) return false;
+  }
+  return true;
+}
+template <typename Tp>
+bool naive_less(const mystl::vector<Tp>& x, const mystl::vector<Tp>& y) {
+  for (size_t i = 0; i < x.size() && i < y.size(); ++i) {
+    if (x[i] < y[i]) return true;
+    if (y[i] < x[i]) return false;
+  }
+  return x.size() < y.size();
+}
+template <typename Tp>
+int compare_both_ways(const mystl::vector<Tp>& x,
+                      const mystl::vector<Tp>& y) {
+  int failures = 0;
+  if ((x == y) != naive_equal(x, y)) ++failures;
+  if ((x < y) != naive_less(x, y)) ++failures;
+  if ((y < x) != naive_less(y, x)) ++failures;
+  return failures;
+}
+
+// Lengths are in bytes. Each element in turn is changed in one byte at a
+// time; flipping the top bit of the top byte changes the sign, so a
+// byte-wise ordering would get signed types wrong.
+template <typename Tp>
+int check_vector(const char* name) {
+  int failures = 0;
+  for (size_t l = 0; l < length_count; ++l) {
+    size_t n = lengths[l] / sizeof(Tp);
+    mystl::vector<Tp> x, y;
+    for (size_t i = 0; i < n; ++i) {
+      x.push_back(Tp(next_random() * 2654435761u));
+    }
+    y = x;
+    failures += compare_both_ways(x, y);
+    for (size_t d = 0; d < n; ++d) {
+      unsigned char* bytes = reinterpret_cast<unsigned char*>(&y[d]);
+      for (size_t b = 0; b < sizeof(Tp); ++b) {
+        bytes[b] ^= 0x80;
+        failures += compare_both_ways(x, y);
+        bytes[b] ^= 0x80;
+      }
+      y[d] = Tp(-x[d] - 1);
+      failures += compare_both_ways(x, y);
+      y[d] = x[d];
+    }
+    // A proper prefix orders first.
+    if (n > 0) {
+      y.pop_back();
+      failures += compare_both_ways(x, y);
+    }
+  }
+  std::cout << name << ": " << failures << " failed\n";
+  return failures;
+}
+
+int main() {
+  int failures = 0;
+#if defined(__SSE2__)
+  failures += check_kernel("mismatch_bytes_sse2", mystl::mismatch_bytes_sse2);
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    failures += check_kernel("mismatch_bytes_avx2",
+                             mystl::mismatch_bytes_avx2);
+  } else {
+    std::cout << "mismatch_bytes_avx2: skipped, no AVX2\n";
+  }
+#endif
+  failures += check_kernel("mismatch_bytes_scalar",
+                           mystl::mismatch_bytes_scalar);
+  failures += check_vector<signed char>("vector<signed char>");
+  failures += check_vector<unsigned char>("vector<unsigned char>");
+  failures += check_vector<short>("vector<short>");
+  failures += check_vector<int>("vector<int>");
+  failures += check_vector<unsigned>("vector<unsigned>");
+  failures += check_vector<long long>("vector<long long>");
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright 2016 Waizung Taam
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ==== concurrent_vector demo ==== */
+
+// $ ./concurrent_vector_demo.o
+
+#include "../include/concurrent_vector.h"
+
+#include <iostream>
+#include <string>
+#include <thread>
+
+template <typename Vector>
+void print(const Vector& v) {
+  std::cout << "size: " << v.size() << "\tcapacity: " << v.capacity() << "\t";
+  for (size_t i = 0; i < v.size() && i < 10; ++i) std::cout << v[i] << " ";
+  if (v.size() > 10) std::cout << "...";
+  std::cout << "\n";  
+}
+
+int main() {
+  mystl::concurrent_vector<int> a;
+  int& first = a.push_back(42);
+  std::thread workers[4];
+  for (int t = 0; t < 4; ++t) {
+    workers[t] = std::thread([&a, t]() {
+      for (int i = 0; i < 1000; ++i) a.push_back(1);
+      int block[3] = {t, t, t};
+      a.grow_by(block, block + 3);
+    });
+  }
+  for (int t = 0; t < 4; ++t) workers[t].join();
+  long sum = 0;
+  for (mystl::concurrent_vector<int>::const_iterator it = a.begin(); 
+       it != a.end(); ++it) {
+    sum += *it;
+  }
+  // 42 + 4000 + 3 * (0 + 1 + 2 + 3)
+  std::cout << "sum: " << sum << "\tfirst: " << first << "\n";
+  print(a);
+
+  mystl::vector<int> b = a.compact();
+  std::cout << "size: " << b.size() << "\tcompacted: " << a.size() << "\n";
+
+  mystl::concurrent_vector<std::string> c;
+  c.reserve(100);
+  size_t pos = c.grow_by(3, std::string(20, 'x'));
+  c.emplace_back(5, 'y');
+  c[pos + 1] += "z";
+  print(c);
+  try {
+    c.at(4);
+  } catch (const char* e) {
+    std::cout << e << "\n";
+  }
+  mystl::vector<std::string> d = c.compact();
+  print(d);
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright 2016 Waizung Taam
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ==== cow_vector demo ==== */
+
+// $ valgrind --leak-check=full ./cow_vector_demo.o
+
+#include "../include/cow_vector.h"
+
+#include <iostream>
+
+typedef mystl::cow_vector<int> Vector;
+
+void print(const Vector& v) {
+  std::cout << "size: " << v.size() << "\tcapacity: " << v.capacity()
+            << "\tuse_count: " << v.use_count() << "\t";
+  for (Vector::const_iterator it = v.begin(); it != v.end(); ++it) {
+    std::cout << *it << " ";
+  }
+  std::cout << "\n";
+}
+
+int main() {
+  Vector a;
+  for (int i = 0; i < 5; ++i) a.push_back(i);
+  print(a);
+
+  Vector b = a;
+  Vector c = b;
+  print(a);
+  std::cout << (a.cbegin() == c.cbegin()) << "\n";
+
+  b.push_back(5);
+  print(a);
+  print(b);
+
+  c.insert(c.cbegin() + 1, 2, 10);
+  print(c);
+  c.erase(c.cbegin(), c.cbegin() + 2);
+  print(c);
+  print(a);
+
+  // A reference taken into a makes later copies of a deep.
+  int& first = a[0];
+  Vector d = a;
+  first = 100;
+  print(a);
+  print(d);
+
+  // Assignment makes a shareable again.
+  a = d;
+  print(a);
+
+  mystl::vector<int> items(3, 7);
+  Vector e(mystl::move(items));
+  Vector f = e;
+  print(f);
+  f.clear();
+  print(e);
+  print(f);
+
+  std::cout << (a == d) << " " << (b < a) << " " << (e != f) << "\n";
+}
@@ -0,0 +1,69 @@
+/*
+ * Copyright 2016 Waizung Taam
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ==== flat_map demo ==== */
+
+// $ valgrind --leak-check=full ./flat_map_demo.o
+
+#include "../include/flat_map.h"
+
+#include <iostream>
+#include <string>
+
+typedef mystl::flat_map<int, std::string> Map;
+
+void print(const Map& m) {
+  std::cout << "size: " << m.size() << "\tcapacity: " << m.capacity() << "\t";
+  for (Map::const_iterator it = m.begin(); it != m.end(); ++it) {
+    std::cout << it->first << ":" << it->second << " ";
+  }
+  std::cout << "\n";
+}
+
+int main() {
+  Map a;
+  a[3] = "c";
+  a[1] = "a";
+  a[2] = "b";
+  print(a);
+  std::cout << a.insert(mystl::make_pair(2, std::string("x"))).second << " "
+            << a.insert(mystl::make_pair(4, std::string("d"))).second << "\n";
+  print(a);
+
+  mystl::pair<int, std::string> sorted[] = {
+    mystl::make_pair(0, std::string("z")),
+    mystl::make_pair(2, std::string("y")),
+    mystl::make_pair(6, std::string("f")),
+  };
+  std::cout << a.insert_sorted(sorted, sorted + 3) << "\n";
+  print(a);
+
+  Map::iterator it = a.find(6);
+  it->second = "F";
+  std::cout << a.at(6) << " " << a.contains(5) << "\n";
+  try {
+    a.at(5);
+  } catch (const char* error) {
+    std::cout << error << "\n";
+  }
+
+  a.build_index();
+  std::cout << a.has_index() << " " << a.lower_bound(5)->first << " "
+            << a.upper_bound(2)->first << "\n";
+  a.erase(0);
+  a.erase(a.find(3));
+  print(a);
+}
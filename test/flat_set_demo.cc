@@ -0,0 +1,67 @@
+/*
+ * Copyright 2016 Waizung Taam
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ==== flat_set demo ==== */
+
+// $ valgrind --leak-check=full ./flat_set_demo.o
+
+#include "../include/flat_set.h"
+
+#include <iostream>
+
+typedef mystl::flat_set<int> Set;
+
+void print(const Set& s) {
+  std::cout << "size: " << s.size() << "\tcapacity: " << s.capacity() << "\t";
+  for (Set::const_iterator it = s.begin(); it != s.end(); ++it) {
+    std::cout << *it << " ";
+  }
+  std::cout << "\n";
+}
+
+int main() {
+  Set a;
+  for (int i = 0; i < 10; ++i) a.insert((i * 7) % 10);
+  print(a);
+  std::cout << a.insert(3).second << " " << a.insert(10).second << "\n";
+
+  int sorted[] = {-2, 4, 4, 11, 12};
+  std::cout << a.insert_sorted(sorted, sorted + 5) << "\n";
+  print(a);
+  int unsorted[] = {30, 20, 25, 20, -1};
+  std::cout << a.insert(unsorted, unsorted + 5) << "\n";
+  print(a);
+
+  std::cout << a.erase(4) << " " << a.erase(4) << "\n";
+  a.erase(a.begin(), a.begin() + 2);
+  print(a);
+
+  std::cout << *a.lower_bound(13) << " " << *a.upper_bound(20) << " "
+            << a.contains(7) << " " << a.count(8) << "\n";
+
+  a.build_index();
+  std::cout << a.has_index() << " " << *a.find(25) << " "
+            << (a.find(26) == a.end()) << " " << *a.lower_bound(21) << "\n";
+  a.insert(26);
+  std::cout << a.has_index() << "\n";
+
+  mystl::vector<int> keys;
+  for (int i = 0; i < 5; ++i) keys.push_back(i * i);
+  Set b(mystl::sorted_unique, mystl::move(keys));
+  print(b);
+  Set c(b.begin(), b.end());
+  std::cout << (b == c) << " " << (a != c) << "\n";
+}
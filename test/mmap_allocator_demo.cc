@@ -0,0 +1,71 @@
+/*
+ * Copyright 2016 Waizung Taam
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ==== mmap allocator demo ==== */
+
+// $ ./mmap_allocator_demo.o
+
+#include "../include/mmap_allocator.h"
+
+#include <cstdio>
+#include <iostream>
+
+template <typename Vector>
+void print(const Vector& v) {
+  std::cout << "size: " << v.size() << "\tcapacity: " << v.capacity() << "\t";
+  for (const int& x : v) std::cout << x << " ";
+  std::cout << "\n";  
+}
+
+int main() {
+  mystl::vector<int, mystl::mmap_allocator<int>> a;
+  for (int i = 0; i < 10; ++i) {
+    a.push_back(i);
+  }
+  print(a);
+  a.insert(a.begin() + 5, 3, 10);
+  print(a);
+  a.shrink_to_fit();
+  print(a);
+
+  const char* path = "mmap_allocator_demo.vec";
+  std::remove(path);
+  {
+    mystl::mmap_vector<int> b(path);
+    print(b);
+    for (int i = 0; i < 5; ++i) {
+      b.push_back(i * i);
+    }
+    b.append(b.data(), b.size());
+    print(b);
+  }
+  {
+    mystl::mmap_vector<int> c(path);
+    print(c);
+    c.erase(c.begin() + 5, c.end());
+    c.shrink_to_fit();
+  }
+  {
+    mystl::mmap_vector<int> d(path);
+    print(d);
+    try {
+      mystl::mmap_vector<double> e(path);
+    } catch (const char* message) {
+      std::cout << message << "\n";
+    }
+  }
+  std::remove(path);
+}
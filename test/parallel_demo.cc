@@ -0,0 +1,63 @@
+/*
+ * Copyright 2016 Waizung Taam
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ==== parallel algorithms demo ==== */
+
+// $ ./parallel_demo.o
+
+#include "../include/parallel.h"
+
+#include <iostream>
+#include <string>
+
+template <typename Vector>
+void print(const Vector& v) {
+  std::cout << "size: " << v.size() << "\tcapacity: " << v.capacity() << "\t";
+  for (size_t i = 0; i < v.size() && i < 10; ++i) std::cout << v[i] << " ";
+  if (v.size() > 10) std::cout << "...";
+  std::cout << "\n";  
+}
+
+int main() {
+  mystl::thread_pool pool(4);
+  // A zero threshold splits even tiny ranges, to show the chunking.
+  mystl::parallel_policy par(&pool, 0);
+
+  mystl::parallel_vector<int> a(10, 7, par);
+  print(a);
+  mystl::parallel_vector<int> b(a);
+  mystl::parallel_transform(par, b.data(), b.data() + b.size(), b.data(),
+                            [](int x) { return x * 3; });
+  print(b);
+  mystl::parallel_fill(par, b.begin() + 5, b.end(), 1);
+  print(b);
+  std::cout << "sum: " << mystl::parallel_reduce(par, b.data(), 
+    b.data() + b.size(), 0, [](int x, int y) { return x + y; }) << "\n";
+
+  mystl::parallel_vector<long> c(1000000, par);
+  mystl::parallel_transform(par, c.data(), c.data() + c.size(), c.data(),
+                            [](long) { return 1L; });
+  std::cout << "sum: " << mystl::parallel_reduce(par, c.data(), 
+    c.data() + c.size(), 0L, [](long x, long y) { return x + y; }) << "\n";
+  mystl::vector<long> d(mystl::move(c));
+  print(d);
+
+  mystl::parallel_vector<std::string> e(5, std::string(20, 'x'), par);
+  e.assign(3, e[0] + "y");
+  print(e);
+  e.push_back("z");
+  print(e);
+}
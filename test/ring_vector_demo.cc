@@ -0,0 +1,98 @@
+/*
+ * Copyright 2016 Waizung Taam
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ==== ring_vector demo ==== */
+
+// $ valgrind --leak-check=full ./ring_vector_demo.o
+
+#include "../include/ring_vector.h"
+
+#include <iostream>
+#include <string>
+
+template <typename Vector>
+void print(const Vector& v) {
+  std::cout << "size: " << v.size() << "\tcapacity: " << v.capacity()
+            << "\tlinear: " << v.is_linear() << "\t";
+  for (typename Vector::const_iterator it = v.begin(); it != v.end(); ++it) {
+    std::cout << *it << " ";
+  }
+  std::cout << "\n";
+}
+
+int main() {
+  mystl::ring_vector<int> a;
+  for (int i = 0; i < 6; ++i) a.push_back(i);
+  print(a);
+  a.push_front(-1);
+  a.push_front(-2);
+  print(a);
+  a.push_front(-3);                     // full: doubles
+  print(a);
+  a.pop_front();
+  a.pop_back();
+  print(a);
+  std::cout << "a[0]: " << a[0] << "\ta.back(): " << a.back()
+            << "\tend - begin: " << a.end() - a.begin() << "\n";
+  for (mystl::ring_vector<int>::reverse_iterator r = a.rbegin();
+       r != a.rend(); ++r) {
+    std::cout << *r << " ";
+  }
+  std::cout << "\n";
+
+  // A sliding window of the last 4 values and their sum.
+  mystl::ring_vector<int> window;
+  long sum = 0;
+  for (int tick = 0; tick < 10; ++tick) {
+    window.push_back(tick * tick);
+    sum += window.back();
+    if (window.size() > 4) {
+      sum -= window.front();
+      window.pop_front();
+    }
+  }
+  std::cout << "window sum: " << sum << "\t";
+  print(window);
+  mystl::span<int> flat = window.linearize();
+  std::cout << "linearized: ";
+  for (size_t i = 0; i < flat.size(); ++i) std::cout << flat[i] << " ";
+  std::cout << "\n";
+  print(window);
+
+  mystl::ring_vector<int> b;
+  mystl::front_insert_iterator<mystl::ring_vector<int>> front(b);
+  for (int i = 0; i < 5; ++i) *front++ = i;
+  print(b);
+  mystl::ring_vector<int> c(b);
+  std::cout << "b == c: " << (b == c) << "\t";
+  c.back() = 10;
+  std::cout << "b < c: " << (b < c) << "\n";
+
+  mystl::ring_vector<std::string> d(3, "ring");
+  d.emplace_front(2, 'x');
+  d.emplace_back("back");
+  print(d);
+  mystl::ring_vector<std::string> e(mystl::move(d));
+  print(d);
+  print(e);
+  e.shrink_to_fit();
+  print(e);
+  try {
+    e.at(5);
+  } catch (const char* msg) {
+    std::cout << msg << "\n";
+  }
+}
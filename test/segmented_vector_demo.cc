@@ -0,0 +1,92 @@
+/*
+ * Copyright 2016 Waizung Taam
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ==== segmented_vector demo ==== */
+
+// $ valgrind --leak-check=full ./segmented_vector_demo.o
+
+#include "../include/segmented_vector.h"
+
+#include <iostream>
+#include <string>
+
+// Segments of 2, 4, 8, ... elements, to show the boundaries.
+template <typename Tp>
+using SegmentedVector = 
+  mystl::segmented_vector<Tp, mystl::new_allocator<Tp>, 1>;
+
+template <typename Vector>
+void print(const Vector& v) {
+  std::cout << "size: " << v.size() << "\tcapacity: " << v.capacity() << "\t";
+  for (typename Vector::const_iterator it = v.begin(); it != v.end(); ++it) {
+    std::cout << *it << " ";
+  }
+  std::cout << "\n";  
+}
+
+int main() {
+  SegmentedVector<int> a;
+  a.push_back(0);
+  const int* first = &a[0];
+  for (int i = 1; i < 10; ++i) {
+    a.push_back(i);
+    print(a);
+  }
+  std::cout << "first element moved: " << (first != &a[0]) << "\n";
+  a.pop_back();
+  a.pop_back();
+  print(a);
+  a.shrink_to_fit();
+  print(a);
+
+  SegmentedVector<int>::iterator it = a.begin() + 5;
+  std::cout << "it[0]: " << *it << "\tit[-3]: " << it[-3] 
+            << "\tend - it: " << a.end() - it << "\n";
+  for (SegmentedVector<int>::reverse_iterator r = a.rbegin(); 
+       r != a.rend(); ++r) {
+    std::cout << *r << " ";
+  }
+  std::cout << "\n";
+
+  SegmentedVector<int> b(a);
+  std::cout << "a == b: " << (a == b) << "\t";
+  b.back() = -1;
+  std::cout << "b < a: " << (b < a) << "\n";
+
+  SegmentedVector<std::string> c(3, "segment");
+  c.emplace_back(4, 'x');
+  c.resize(6, "y");
+  print(c);
+  SegmentedVector<std::string> d(mystl::move(c));
+  print(c);
+  print(d);
+  try {
+    d.at(6);
+  } catch (const char* e) {
+    std::cout << e << "\n";
+  }
+
+  // Popping back onto a segment boundary (2 + 4 elements), then freeing
+  // the emptied segment and growing again.
+  SegmentedVector<int> e;
+  for (int i = 0; i < 7; ++i) e.push_back(i);
+  e.pop_back();
+  std::cout << "back: " << e.back() << "\t";
+  e.shrink_to_fit();
+  e.push_back(60);
+  e.push_back(70);
+  print(e);
+}
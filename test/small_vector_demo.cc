@@ -0,0 +1,77 @@
+/*
+ * Copyright 2016 Waizung Taam
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ==== small_vector demo ==== */
+
+// $ valgrind --leak-check=full ./small_vector_demo.o
+
+#include "../include/small_vector.h"
+
+#include <iostream>
+
+template <typename Tp>
+using SmallVector = mystl::small_vector<Tp, 4>;
+
+template <typename Tp>
+void print(const SmallVector<Tp>& v) {
+  std::cout << "size: " << v.size() << "\tcapacity: " << v.capacity() 
+            << "\tinline: " << v.is_inline() << "\t";
+  for (const int& x : v) std::cout << x << " ";
+  std::cout << "\n";  
+}
+
+int main() {
+  SmallVector<int> a;
+  for (int i = 0; i < 6; ++i) {
+    a.push_back(i);
+    print(a);
+  }
+  a.erase(a.begin() + 3, a.end());
+  print(a);
+  a.shrink_to_fit();
+  print(a);
+
+  SmallVector<int> b(a);
+  print(b);
+  SmallVector<int> c(mystl::move(b));
+  print(b);
+  print(c);
+
+  SmallVector<int> d(10, 1);
+  print(d);
+  d.swap(c);
+  print(c);
+  print(d);
+
+  // Growing a vector of small_vectors moves their heap buffers.
+  mystl::vector<SmallVector<int>> rows(1, c);
+  const int* row_data = rows[0].data();
+  for (int i = 0; i < 8; ++i) rows.push_back(c);
+  std::cout << "rows: " << rows.size() << "\tfirst row moved: "
+            << (rows[0].data() == row_data) << "\n";
+
+  // A trimming policy shrinks back into the inline buffer, never below it.
+  mystl::small_vector<int, 4, mystl::new_allocator<int>,
+                      mystl::trimming_growth<>> e;
+  for (int i = 0; i < 6; ++i) e.push_back(i);
+  e.erase(e.begin() + 1, e.end());
+  std::cout << "trimmed: size: " << e.size() << "\tcapacity: "
+            << e.capacity() << "\tinline: " << e.is_inline() << "\n";
+  for (int i = 1; i < 6; ++i) e.push_back(i);
+  while (!e.empty()) e.pop_back();
+  std::cout << "emptied: capacity: " << e.capacity() << "\tinline: "
+            << e.is_inline() << "\n";
+}
@@ -0,0 +1,70 @@
+/*
+ * Copyright 2016 Waizung Taam
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ==== soa_vector demo ==== */
+
+// $ valgrind --leak-check=full ./soa_vector_demo.o
+
+#include "../include/soa_vector.h"
+
+#include <iostream>
+#include <string>
+
+// id, name, price
+typedef mystl::soa_vector<int, std::string, double> Table;
+
+void print(const Table& t) {
+  std::cout << "size: " << t.size() << "\tcapacity: " << t.capacity() << "\t";
+  for (Table::const_iterator it = t.begin(); it != t.end(); ++it) {
+    std::cout << "(" << mystl::get<0>(*it) << ", " << mystl::get<1>(*it) 
+              << ", " << mystl::get<double>(*it) << ") ";
+  }
+  std::cout << "\n";
+}
+
+int main() {
+  Table t;
+  for (int i = 0; i < 5; ++i) {
+    t.push_back(i, std::string(1, char('a' + i)), i * 1.5);
+    print(t);
+  }
+
+  // Column-wise: one contiguous array per field.
+  mystl::span<double> prices = t.column<2>();
+  for (size_t i = 0; i < prices.size(); ++i) prices[i] *= 2;
+  double total = 0;
+  for (double* p = prices.begin(); p != prices.end(); ++p) total += *p;
+  std::cout << "total: " << total << "\n";
+
+  // Row-wise, through proxies.
+  Table::value_type row = t[4];
+  t[0] = row;
+  mystl::get<1>(t[1]) = "renamed";
+  swap(t[2], t[3]);
+  print(t);
+
+  Table u(t);
+  t.pop_back();
+  std::cout << "t == u: " << (t == u) << "\n";
+  t.resize(2);
+  t.shrink_to_fit();
+  print(t);
+  try {
+    t.at(2);
+  } catch (const char* e) {
+    std::cout << e << "\n";
+  }
+}
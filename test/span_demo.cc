@@ -0,0 +1,76 @@
+/*
+ * Copyright 2016 Waizung Taam
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ==== span demo ==== */
+
+// $ ./span_demo.o
+
+#include "../include/span.h"
+
+#include <iostream>
+
+void print(mystl::span<const int> s) {
+  std::cout << "size: " << s.size() << "\t";
+  for (mystl::span<const int>::iterator it = s.begin(); it != s.end(); ++it) {
+    std::cout << *it << " ";
+  }
+  std::cout << "\n";
+}
+
+void increment(mystl::span<int> s) {
+  for (size_t i = 0; i < s.size(); ++i) ++s[i];
+}
+
+int main() {
+  mystl::vector<int> v;
+  for (int i = 0; i < 10; ++i) v.push_back(i);
+  print(v);
+
+  mystl::span<int> all = v;
+  print(all.first(3));
+  print(all.last(3));
+  print(all.subspan(4));
+  print(all.subspan(4, 2));
+
+  increment(all.subspan(5));
+  print(v);
+
+  const mystl::vector<int>& cv = v;
+  mystl::span<const int> view = cv;
+  std::cout << view.front() << " " << view.back() << " " << view.at(2)
+            << " " << view.size_bytes() << "\n";
+  for (mystl::span<const int>::reverse_iterator it = view.rbegin();
+       it != view.rend(); ++it) {
+    std::cout << *it << " ";
+  }
+  std::cout << "\n";
+  std::cout << mystl::distance(view.begin(), view.end()) << "\n";
+
+  int array[] = {20, 21, 22};
+  print(array);
+  print(mystl::span<int>());
+
+  try {
+    view.at(10);
+  } catch (const char* error) {
+    std::cout << error << "\n";
+  }
+  try {
+    all.subspan(8, 3);
+  } catch (const char* error) {
+    std::cout << error << "\n";
+  }
+}
@@ -25,9 +25,12 @@
 
 template <typename Tp>
 using Vector = mystl::vector<Tp>;
-
 template <typename Tp>
-void print(const Vector<Tp>& v) {
+using TrimmingVector =
+  mystl::vector<Tp, mystl::new_allocator<Tp>, mystl::trimming_growth<>>;
+
+template <typename Vec>
+void print(const Vec& v) {
   std::cout << "size: " << v.size() << "\tcapacity: " << v.capacity() << "\t";
   for (const int& x : v) std::cout << x << " ";
   std::cout << "\n";  
@@ -89,6 +92,11 @@ int main() {
   d.insert(d.begin() + 2, c.begin(), c.begin() + 2);
   print(d);
 
+  d.emplace_back(14);
+  print(d);
+  d.emplace(d.begin() + 1, 15);
+  print(d);
+
   d.erase(d.begin());
   print(d);
   d.erase(d.begin() + 5, d.end());
@@ -98,9 +106,52 @@ int main() {
   print(d);
   d.resize(4);
   print(d);
+  int* tail = d.append_uninitialized(2);
+  tail[0] = 16;
+  tail[1] = 17;
+  print(d);
+  d.append(d.data(), 3);
+  print(d);
+  d.resize_default_init(5);
+  print(d);
+  d.erase_unordered(d.begin());
+  print(d);
+  d.erase_if([](int x) { return x % 2 == 0; });
+  print(d);
+  size_t indices[] = {0, 2, 2};
+  d.erase_indices(indices, indices + 3);
+  print(d);
 
   print(c);
   d.swap(c);
   print(d);
   print(c);
+
+  // shrink_to(n) keeps room for n elements, but never for fewer than
+  // size(), and never grows the vector.
+  Vector<int> f(20, 1);
+  f.resize(5);
+  f.shrink_to(8);
+  print(f);                             // capacity: 8
+  f.shrink_to(2);
+  print(f);                             // capacity: 5
+  f.shrink_to(10);
+  print(f);                             // capacity: 5
+  f.resize(3);
+  f.shrink_to_fit();
+  print(f);                             // capacity: 3
+
+  // trimming_growth trims the capacity to twice the size once less than a
+  // quarter of it is in use, and frees the buffer once the vector empties.
+  TrimmingVector<int> g;
+  for (int i = 0; i < 16; ++i) g.push_back(i);
+  print(g);                             // capacity: 16
+  g.erase(g.begin() + 4, g.end());
+  print(g);                             // capacity: 16
+  g.erase(g.begin());
+  print(g);                             // capacity: 6
+  g.erase_if([](int x) { return x != 2; });
+  print(g);                             // capacity: 2
+  g.pop_back();
+  print(g);                             // capacity: 0
 }
\ No newline at end of file
@@ -0,0 +1,94 @@
+/*
+ * Copyright 2016 Waizung Taam
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ==== vector binary I/O demo ==== */
+
+// $ ./vector_io_demo.o
+
+#include "../include/vector_io.h"
+
+#include <fcntl.h>
+
+#include <cstdio>
+#include <iostream>
+
+struct Entry {
+  int key;
+  double weight;
+};
+
+template <typename Vector>
+void print(const Vector& v) {
+  std::cout << "size: " << v.size() << "\tcapacity: " << v.capacity() << "\t";
+  for (size_t i = 0; i < v.size(); ++i) std::cout << v[i].key << " ";
+  std::cout << "\n";
+}
+
+int main() {
+  const char* path = "vector_io_demo.bin";
+  mystl::vector<Entry> a;
+  for (int i = 0; i < 10; ++i) {
+    Entry e = {i, i * 0.5};
+    a.push_back(e);
+  }
+  print(a);
+
+  int fd = ::open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  mystl::write_to(fd, a);
+  ::close(fd);
+
+  mystl::vector<Entry> b;
+  fd = ::open(path, O_RDONLY);
+  mystl::read_from(fd, b);
+  ::close(fd);
+  print(b);
+  std::cout << "weight of 9: " << b[9].weight << "\n";
+
+  fd = ::open(path, O_RDONLY);
+  mystl::vector_reader<Entry> reader(fd);
+  std::cout << "stream size: " << reader.size() << "\n";
+  mystl::vector<Entry> chunk;
+  while (reader.read(chunk, 4) > 0) {
+    print(chunk);
+    chunk.clear();
+  }
+  ::close(fd);
+
+  // A corrupted element fails the checksum.
+  fd = ::open(path, O_WRONLY);
+  ::pwrite(fd, "x", 1, sizeof(mystl::vector_io_header));
+  ::close(fd);
+  fd = ::open(path, O_RDONLY);
+  try {
+    mystl::read_from(fd, b);
+  } catch (const char* error) {
+    std::cout << error << "\n";
+  }
+  ::close(fd);
+  print(b);
+
+  // So does reading a stream as the wrong element type.
+  fd = ::open(path, O_RDONLY);
+  try {
+    mystl::vector<int> c;
+    mystl::read_from(fd, c);
+  } catch (const char* error) {
+    std::cout << error << "\n";
+  }
+  ::close(fd);
+
+  std::remove(path);
+}
@@ -0,0 +1,65 @@
+/*
+ * Copyright 2016 Waizung Taam
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* ==== vector statistics demo ==== */
+
+// $ ./vector_stats_demo.o
+
+#define MYSTL_VECTOR_STATS
+#include "../include/vector.h"
+#include "../include/mmap_allocator.h"
+
+#include <cstdio>
+#include <string>
+
+int main() {
+  {
+    mystl::vector<int> a;
+    for (int i = 0; i < 1000; ++i) {
+      a.push_back(i);
+    }
+    mystl::vector<int> b;
+    b.reserve(1000);
+    for (int i = 0; i < 1000; ++i) {
+      b.push_back(i);
+    }
+    mystl::vector<int> c;
+    c = a;
+    c.insert(c.begin(), a.begin(), a.end());
+  }
+  {
+    mystl::vector<std::string> s;
+    for (int i = 0; i < 100; ++i) {
+      s.push_back(std::string(40, 'x'));
+    }
+    s.shrink_to_fit();
+  }
+  mystl::vector_stats_report(stdout);
+  mystl::vector_stats_reset();
+  {
+    mystl::vector<int> d(10, 1);
+  }
+  mystl::vector_stats_report(stdout);
+  mystl::vector_stats_reset();
+  // Growth through mremap() is counted like any other.
+  {
+    mystl::vector<int, mystl::mmap_allocator<int>> e;
+    for (int i = 0; i < 1000; ++i) {
+      e.push_back(i);
+    }
+  }
+  mystl::vector_stats_report(stdout);
+}